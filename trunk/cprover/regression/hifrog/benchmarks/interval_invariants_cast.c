@@ -0,0 +1,16 @@
+int nondet_int();
+
+void check(unsigned char x)
+{
+  assert(0);
+}
+
+int main()
+{
+  int y = nondet_int();
+  __CPROVER_assume(y >= 256 && y <= 300);
+  // the cast wraps around, x is in [0,44] and not in the interval of y
+  unsigned char x = (unsigned char)y;
+  if (x < 100)
+    check(x);
+}
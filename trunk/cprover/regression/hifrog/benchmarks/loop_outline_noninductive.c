@@ -0,0 +1,24 @@
+int nondet_int();
+
+int count(int n)
+{
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s++;
+  return s;
+}
+
+int main()
+{
+  int n = nondet_int();
+  if (n <= 2) {
+    // the summaries of the loop found here bound s by a constant: not inductive
+    int c = count(n);
+    assert(c <= 2);
+  }
+  if (n <= 4) {
+    // within the unwind bound: the recursive calls stay havocked
+    int d = count(n);
+    assert(d <= 4);
+  }
+}
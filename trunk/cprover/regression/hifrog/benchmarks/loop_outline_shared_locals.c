@@ -0,0 +1,11 @@
+int main()
+{
+  int x = 0;
+  int y = 10;
+  // x and y are shared with the outlined loop, i is not
+  for (int i = 0; i < 3; i++) {
+    x += 2;
+    y--;
+  }
+  assert(x == 6 && y == 7);
+}
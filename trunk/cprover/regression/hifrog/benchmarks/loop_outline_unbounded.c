@@ -0,0 +1,22 @@
+int nondet_int();
+
+int count(int n)
+{
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s++;
+  return s;
+}
+
+int main()
+{
+  int n = nondet_int();
+  if (n <= 2) {
+    // the summary of the loop found here (s only grows) is inductive
+    int c = count(n);
+    assert(c >= 0);
+  }
+  // any number of iterations: holds only with the summary as the loop invariant
+  int d = count(n);
+  assert(d >= 0);
+}
@@ -0,0 +1,11 @@
+// The guard of the assertion cannot be evaluated by the interpreter (float
+// multiplication), so the replay of the spurious counterexample of the
+// theories must not count as reproduced; the refinement proves the claim.
+int main() {
+  float x = nondetFloat();
+
+  __CPROVER_assume(x > 1.0f);
+  __CPROVER_assume(x < 100.0f);
+
+  assert(x*0.5f < x);
+}
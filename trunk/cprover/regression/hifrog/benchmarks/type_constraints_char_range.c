@@ -0,0 +1,9 @@
+signed char nondet_char();
+
+int main()
+{
+  signed char c = nondet_char();
+  signed char d = c;
+  // d is only copied and compared, yet 200 is out of its range
+  assert((int)d != 200);
+}
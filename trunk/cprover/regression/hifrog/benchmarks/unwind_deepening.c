@@ -0,0 +1,8 @@
+int main()
+{
+  int x = 0;
+  for (int i = 0; i < 5; i++)
+    x += 2;
+  // holds with the loop cut at bound 1, fails at bound 7
+  assert(x != 10);
+}
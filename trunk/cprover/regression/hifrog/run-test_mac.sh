@@ -28,6 +28,7 @@ function test_one {
   HIFROG_TIME="${FILE_PREFIX}_time.txt"
   EXPECTED_OUTPUT="${INPUT}_out"
   EXPECTED_OUTPUT_CUF="${FILE_PREFIX}_cuf_expected_res.txt"
+  EXPECTED_OUTPUT_VERDICT="${FILE_PREFIX}_verdict_expected_res.txt"
   IND=$((IND+1))
 
   if [[ ! -r ${INPUT} ]] ; then
@@ -39,8 +40,12 @@ function test_one {
     return 1
   fi
   
-  # $p3 is where is the expected output	
-  if (("${#3}" > 1))
+  # $p3 is where is the expected output, or "verdict" to compare only the verification result
+  VERDICT_ONLY=0
+  if [ "$3" == "verdict" ]
+  then
+    VERDICT_ONLY=1
+  elif (("${#3}" > 1))
   then
     p3="${3%\"}"
     p3="${p3#\"}" 
@@ -96,7 +101,14 @@ function test_one {
   fi
 
   # patch for cuf till it will support full functionality of hifrog (as other theories)
-  if [ "$2" == "$QFCUF" ]
+  if [ "$VERDICT_ONLY" == "1" ]
+  then
+    cat ${HIFROG_OUTPUT} | ${FILTER_VERDICT} > ${HIFROG_RESULT}
+    cat ${HIFROG_OUTPUT} | ${FILTER_TIME} > ${HIFROG_TIME}
+    cat ${EXPECTED_OUTPUT} | ${FILTER_VERDICT} > ${EXPECTED_OUTPUT_VERDICT}
+
+    check_result ${HIFROG_RESULT} ${EXPECTED_OUTPUT_VERDICT}
+  elif [ "$2" == "$QFCUF" ]
   then
     # Filter the relevant information
     cat ${HIFROG_OUTPUT} | ${FILTER_RESULT_CUF} > ${HIFROG_RESULT}
@@ -127,6 +139,7 @@ echo " - path regression tests: $PATH_reg"
 
 FILTER_RESULT="./filter-result.sh"
 FILTER_RESULT_CUF="./filter-result-cuf.sh"
+FILTER_VERDICT="./filter-verdict.sh"
 FILTER_TIME="./filter-time.sh"
 OUTPUT_PREFIX="output"
 IND=1
@@ -10,6 +10,9 @@ Basically in each function call it assigns a level of abstraction(summary, inlin
 #include "call_tree_node.h"
 #include "assertion_info.h"
 #include <util/std_expr.h>
+#include <util/irep_hash.h>
+
+#include <algorithm>
 /*******************************************************************
 //Purpose: Takes the location of assertion into consideration, to set
 // the precision of function calls; for instance if the function call
@@ -18,11 +21,12 @@ Basically in each function call it assigns a level of abstraction(summary, inlin
 void call_tree_nodet::set_initial_precision(
         const summary_precisiont default_precision,
         const std::function<bool(const std::string &)> & has_summary,
-        const unsigned last_assertion_loc)
+        const unsigned last_assertion_loc,
+        const std::function<summary_idt(const call_tree_nodet &)> & find_summary)
 {
   for (auto & call_site : call_sites)
   {
-    call_tree_nodet& function = call_site.second;
+    call_tree_nodet& function = *call_site.second;
     //std::string function_id = id2string(function.get_function_id());
     std::string function_name = function.get_function_id().c_str();  //equivalent to the above line
 
@@ -41,8 +45,18 @@ void call_tree_nodet::set_initial_precision(
     }
     else {
       if (has_summary(function_name)) {
+        // The summary might have been computed at a different call site; reuse it here
+        if (!function.node_has_summary() && find_summary) {
+          function.add_node_sumID(find_summary(function));
+        }
         // If summaries are present, we use them
-        function.set_summary();
+        if (function.node_has_summary() || !find_summary) {
+          function.set_summary();
+        }
+        else {
+          // none of them was computed at a compatible call site
+          function.set_precision(default_precision);
+        }
       }
       else {
         // Otherwise, we use the initial substitution scenario
@@ -52,10 +66,64 @@ void call_tree_nodet::set_initial_precision(
     
     // Recursive traversal of func (DFS) 
     function.set_initial_precision(
-            default_precision, has_summary, last_assertion_loc);
+            default_precision, has_summary, last_assertion_loc, find_summary);
   }
 }
 
+call_tree_nodet* call_tree_nodet::find_call_site(goto_programt::const_targett target) const
+{
+  auto it = std::lower_bound(call_sites.begin(), call_sites.end(), target,
+      [](const call_sitest::value_type & call_site, goto_programt::const_targett t) { return call_site.first < t; });
+  if (it != call_sites.end() && !(target < it->first)) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void call_tree_nodet::add_call_site(goto_programt::const_targett target, call_tree_nodet& node)
+{
+  auto it = std::lower_bound(call_sites.begin(), call_sites.end(), target,
+      [](const call_sitest::value_type & call_site, goto_programt::const_targett t) { return call_site.first < t; });
+  assert(it == call_sites.end() || target < it->first);
+  call_sites.insert(it, std::make_pair(target, &node));
+}
+
+/*******************************************************************
+ Purpose: Shape of the call site: the types of the arguments and of the
+ returned value; the arguments that are constants in the code count
+ with their values, so that f(0) and f(1) are different call sites
+\*******************************************************************/
+std::size_t call_tree_nodet::get_call_site_signature() const
+{
+  std::size_t hash = function_id.hash();
+  if (parent == nullptr) { return hash; }
+  for (const auto & call_site : parent->call_sites) {
+    if (call_site.second != this) { continue; }
+    const code_function_callt & call = to_code_function_call(call_site.first->code);
+    hash = hash_combine(hash, call.lhs().is_nil() ? 0 : call.lhs().type().hash());
+    for (const auto & argument : call.arguments()) {
+      hash = hash_combine(hash, argument.is_constant() ? argument.hash() : argument.type().hash());
+    }
+    break;
+  }
+  return hash;
+}
+
+std::size_t call_tree_nodet::get_calling_context_hash() const
+{
+  // the call sites themselves: two calls of the same caller are different contexts
+  std::size_t hash = 0;
+  for (const call_tree_nodet * node = this; !node->is_root(); node = node->parent) {
+    for (const auto & call_site : node->parent->call_sites) {
+      if (call_site.second == node) {
+        hash = hash_combine(hash, call_site.first->source_location.hash());
+        break;
+      }
+    }
+  }
+  return hash;
+}
+
 bool call_tree_nodet::mark_enabled_assertions(
         const assertion_infot& assertion, unsigned depth,
         bool parent_stack_matches, const unsigned last_assertion_loc)
@@ -65,7 +133,7 @@ bool call_tree_nodet::mark_enabled_assertions(
   for (call_sitest::iterator it = call_sites.begin();
           it != call_sites.end(); ++it) 
   {
-    call_tree_nodet& function = it->second;
+    call_tree_nodet& function = *it->second;
     const irep_idt& function_id = function.get_function_id();
     bool current_stack_matches = assertion.stack_matches(function_id, depth,
             parent_stack_matches);
@@ -95,19 +163,23 @@ bool call_tree_nodet::mark_enabled_assertions(
 }
 
 /*******************************************************************
-//Purpose:
+//Purpose: The call instruction of the node in the parent; NULL for the
+// root and for a node that is not (or no longer) a child of its parent,
+// e.g., after the children of the parent were cleared
 
 \*******************************************************************/
 const goto_programt::const_targett* call_tree_nodet::get_target()
 {
+  if (is_root()) {
+    return NULL;
+  }
   call_sitest& parent_call_sites = get_parent().get_call_sites();
   for (call_sitest::iterator it = parent_call_sites.begin();
           it != parent_call_sites.end(); ++it)
   {
-    if (&(it->second) == this)
+    if (it->second == this)
       return &(it->first);
   }
-  assert(false);
   return NULL;
 }
 
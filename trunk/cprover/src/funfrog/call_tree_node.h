@@ -23,11 +23,19 @@ class assertion_infot;
 // Type of summarization applied at a specific call-site
 typedef enum {HAVOC, SUMMARY, INLINE} summary_precisiont;
 
-typedef std::map<goto_programt::const_targett, call_tree_nodet> call_sitest;
+// Children of a node (sorted by the call instruction); the nodes themselves are owned by the node pool
+typedef std::vector<std::pair<goto_programt::const_targett, call_tree_nodet*>> call_sitest;
 typedef std::map<goto_programt::const_targett, unsigned> location_mapt;
 typedef std::map<goto_programt::const_targett, std::map<unsigned, bool> > location_visitedt;
 typedef std::set<goto_programt::const_targett> locationst;
 
+// Materializes the children of a call tree node on demand (see subst_scenariot)
+class call_tree_expandert {
+public:
+  virtual ~call_tree_expandert() = default;
+  virtual void expand(call_tree_nodet & node) = 0;
+};
+
 // Summary information for a body of a function
 class call_tree_nodet {
 public:
@@ -35,7 +43,11 @@ public:
   call_tree_nodet(call_tree_nodet *_parent, unsigned _call_location)
           : function_id(ID_nil), parent(_parent), node_summaryID(0), assertion_in_subtree(false),  //initially node_summaryID is zero
             precision(HAVOC), call_location(_call_location),
-            preserved_node(false), preserved_edge(false), unwind_exceeded(false), recursion_nondet(false), in_loop(false) { }
+            preserved_node(false), preserved_edge(false), unwind_exceeded(false), recursion_nondet(false), in_loop(false),
+            expander(nullptr), body_location(0) { }
+
+  call_tree_nodet(const call_tree_nodet &) = delete;
+  call_tree_nodet & operator=(const call_tree_nodet &) = delete;
 
   void clear() { call_sites.clear(); }
 
@@ -45,6 +57,29 @@ public:
   // call_end symbol implies all assumptions in the function and inner calls!
   call_sitest& get_call_sites() { return call_sites; }
 
+  // Returns the child corresponding to the given call instruction (nullptr if there is none)
+  call_tree_nodet* find_call_site(goto_programt::const_targett target) const;
+
+  // Registers a child node, keeps the call sites sorted
+  void add_call_site(goto_programt::const_targett target, call_tree_nodet& node);
+
+  // Lazy call tree: the children of the node are materialized only when they
+  // are needed, i.e., when the node gets inlined
+  bool is_expanded() const { return expander == nullptr; }
+  void set_lazy(call_tree_expandert& _expander, unsigned _body_location) {
+    expander = &_expander;
+    body_location = _body_location;
+  }
+  // Global location just before the body of the function (used to number the children)
+  unsigned get_body_location() const { return body_location; }
+  void expand() {
+    if (expander) {
+      auto e = expander;
+      expander = nullptr;
+      e->expand(*this);
+    }
+  }
+
   const goto_programt::const_targett* get_target();
   
   bool node_has_summary() {
@@ -99,12 +134,16 @@ public:
    * default_precision (if none of the rules matches the situation of the node
    * has_summary - a predicate deciding by function name, if there is a summary for that function
    * last_assertion_loc - position of last assertion
+   * find_summary - (optional) returns the ID of a summary computed at another, compatible, call site
+   * of the function (0 if there is none); used for nodes without their own summary, the nodes without
+   * a compatible summary get the default precision
    *
    */
   void set_initial_precision(
         summary_precisiont default_precision,
         const std::function<bool(const std::string &)> & has_summary,
-        unsigned last_assertion_loc);
+        unsigned last_assertion_loc,
+        const std::function<summary_idt(const call_tree_nodet &)> & find_summary = nullptr);
 
   bool mark_enabled_assertions(
         const assertion_infot& assertion, unsigned depth,
@@ -119,18 +158,28 @@ public:
   }
 
   bool is_root() const { return parent == NULL; }
+
+  // Hash of the call instruction of this node: argument types, constant arguments and the returned type
+  std::size_t get_call_site_signature() const;
+
+  // Hash of the calling context, i.e., of the source locations of the calls on the call stack leading to this call
+  std::size_t get_calling_context_hash() const;
   bool has_assertion_in_subtree() const { return assertion_in_subtree; }
   bool is_assertion_enabled(const goto_programt::const_targett& assertion) const {
     return enabled_assertions.find(assertion) != enabled_assertions.end();
   }
 
   call_tree_nodet& get_parent() { return *parent; }
+  const call_tree_nodet& get_parent() const { return *parent; }
   location_mapt& get_assertions() { return assertions; };
 
-  void set_inline() { precision = INLINE; }
+  void set_inline() { expand(); precision = INLINE; }
   void set_summary() { precision = SUMMARY; }
   void set_nondet() { precision = HAVOC; }
-  void set_precision(summary_precisiont _precision) { precision = _precision; }
+  void set_precision(summary_precisiont _precision) {
+    if (_precision == INLINE) { expand(); }
+    precision = _precision;
+  }
   void set_call_location(unsigned loc) { call_location = loc; }
   void set_assertion_in_subtree() { assertion_in_subtree = true; } // false by default
 
@@ -154,7 +203,7 @@ public:
     {
       // more presicely, it should compare pointers to target functions,
       // but in case of nondeterministically treated summaries, it would not work
-      if (it->second.get_function_id() == get_function_id()) return true;
+      if (it->second->get_function_id() == get_function_id()) return true;
     }
     return false;
  }
@@ -195,6 +244,9 @@ private:
   bool unwind_exceeded;
   bool recursion_nondet;
   bool in_loop;
+  // non-null if the children have not been materialized yet
+  call_tree_expandert* expander;
+  unsigned body_location;
   
 
 };
@@ -0,0 +1,145 @@
+/*******************************************************************
+
+ Module: Concrete replay of an error trace on the goto interpreter
+
+\*******************************************************************/
+
+#include "cex_replayer.h"
+
+#include <util/std_code.h>
+
+#include <cstring>
+#include <exception>
+
+// thrown by interpretert::execute_assert when the target assertion fails
+static const char * const assertion_reached="program assertion reached";
+
+cex_replayert::cex_replayert(
+  const symbol_tablet & _symbol_table,
+  const goto_functionst & _goto_functions,
+  message_handlert & _message_handler) :
+  interpretert(_symbol_table, _goto_functions, _message_handler)
+{
+  show=false;
+  thread_id=0;
+  num_dynamic_objects=0;
+}
+
+/*******************************************************************
+ Function: cex_replayert::is_choice
+
+ Purpose: Is the assignment of the trace to full_lhs at the given
+ instruction a nondeterministic choice of symex?
+\*******************************************************************/
+bool cex_replayert::is_choice(
+  const goto_programt::instructiont & instruction,
+  const exprt & full_lhs) const
+{
+  if(instruction.is_assign())
+  {
+    const code_assignt & assign=to_code_assign(instruction.code);
+    return assign.rhs().id()==ID_side_effect &&
+           to_side_effect_expr(assign.rhs()).get_statement()==ID_nondet &&
+           assign.lhs()==full_lhs;
+  }
+  if(instruction.is_function_call())
+  {
+    const code_function_callt & call=to_code_function_call(instruction.code);
+    if(call.lhs().is_nil() || call.lhs()!=full_lhs ||
+       call.function().id()!=ID_symbol)
+      return false;
+    const auto f_it=goto_functions.function_map.find(
+      to_symbol_expr(call.function()).get_identifier());
+    return f_it!=goto_functions.function_map.end() &&
+           !f_it->second.body_available();
+  }
+  return false;
+}
+
+/*******************************************************************
+ Function: cex_replayert::replay_choice
+
+ Purpose: If the current instruction is a nondeterministic choice with a
+ value in the trace, performs it with that value and returns true.
+\*******************************************************************/
+bool cex_replayert::replay_choice()
+{
+  if(pc==function->second.body.instructions.end())
+    return false;
+  const auto it=choices.find(&*pc);
+  if(it==choices.end() || it->second.empty())
+    return false;
+
+  mp_vectort value;
+  evaluate(it->second.front(), value);
+  it->second.pop_front();
+  // a value the interpreter cannot represent, leave it nondeterministic
+  if(value.empty())
+    return false;
+
+  const exprt & lhs=pc->is_assign() ? to_code_assign(pc->code).lhs()
+                                    : to_code_function_call(pc->code).lhs();
+  assign(evaluate_address(lhs), value);
+  ++total_steps;
+  ++pc;
+  return true;
+}
+
+/*******************************************************************
+ Function: cex_replayert::replay
+
+ Purpose: Runs the program from the entry point with the choices of the
+ trace; nondeterminism not fixed by the trace is resolved by the
+ interpreter (any value is a valid execution).
+\*******************************************************************/
+bool cex_replayert::replay(const goto_tracet & trace, std::size_t max_steps)
+{
+  choices.clear();
+  bool has_violation=false;
+  for(const auto & step : trace.steps)
+  {
+    if(step.is_assert() && !step.cond_value)
+    {
+      target_assert=step.pc;
+      has_violation=true;
+    }
+    else if(step.is_assignment() && step.full_lhs_value.is_not_nil() &&
+            is_choice(*step.pc, step.full_lhs))
+    {
+      choices[&*step.pc].push_back(step.full_lhs_value);
+    }
+  }
+  if(!has_violation)
+    return false;
+
+  try
+  {
+    initialize(false);
+    while(!done && total_steps<max_steps)
+    {
+      if(!replay_choice())
+        step();
+    }
+    debug() << "Replay of the counterexample "
+            << (done ? "finished" : "ran out of steps")
+            << " without violating the assertion" << eom;
+  }
+  catch(const char *e)
+  {
+    // the interpreter stops at the failed target assertion; any other
+    // error (e.g., a guard it cannot evaluate) means the trace is not
+    // replayable, even at the target assertion
+    if(pc==target_assert && std::strcmp(e, assertion_reached)==0)
+      return true;
+    debug() << "Replay of the counterexample stopped: " << e << eom;
+  }
+  catch(const std::string &e)
+  {
+    debug() << "Replay of the counterexample stopped: " << e << eom;
+  }
+  catch(const std::exception &e)
+  {
+    debug() << "Replay of the counterexample stopped: " << e.what() << eom;
+  }
+  return false;
+}
@@ -0,0 +1,42 @@
+/*******************************************************************
+
+ Module: Concrete replay of an error trace on the goto interpreter
+
+ The nondeterministic choices along the trace (values of nondet
+ assignments and of calls to functions without a body) are taken from
+ the trace, everything else is executed concretely. If the violated
+ assertion of the trace fails in the replay too, the counterexample is
+ real, whatever over-approximation the encoding used.
+
+\*******************************************************************/
+
+#ifndef HIFROG_CEX_REPLAYER_H
+#define HIFROG_CEX_REPLAYER_H
+
+#include <goto-programs/interpreter_class.h>
+
+#include <deque>
+#include <unordered_map>
+
+class cex_replayert : public interpretert
+{
+public:
+  cex_replayert(
+    const symbol_tablet & _symbol_table,
+    const goto_functionst & _goto_functions,
+    message_handlert & _message_handler);
+
+  // True if the violated assertion of the trace fails in the replay;
+  // false if it holds, the replay diverges or runs out of steps
+  bool replay(const goto_tracet & trace, std::size_t max_steps);
+
+private:
+  typedef std::unordered_map<const goto_programt::instructiont *, std::deque<exprt>> choicest;
+  // values chosen by the trace, per instruction in the order of execution
+  choicest choices;
+
+  bool is_choice(const goto_programt::instructiont & instruction, const exprt & full_lhs) const;
+  bool replay_choice();
+};
+
+#endif //HIFROG_CEX_REPLAYER_H
@@ -6,17 +6,22 @@
 
 #include "check_claims.h"
 #include "core_checker.h"
+#include "unwind_bounds.h"
 #include "theory_refiner.h"
 #include "assertion_info.h"
 #include <util/ui_message.h>
 #include <util/xml.h>
 #include <util/xml_irep.h>
+#include <util/string2int.h>
 #include <ansi-c/expr2c.h>
 #include <funfrog/call_stack.h>
 
+#include <algorithm>
+#include <cassert>
 #include <fstream>
 
 #include "utils/time_utils.h"
+#include "utils/string_utils.h"
 #include <langapi/language_util.h>
 #include "funfrog/upprover/summary_validation.h"
 /*******************************************************************
@@ -91,19 +96,21 @@ Function: check_claims
 
   Inputs:
 
- Outputs:
+ Outputs: true if symex cut some loop by the unwind bound, i.e., the
+ result may be different with a larger bound
 
  Purpose: Core call for checking claims
 
 \*******************************************************************/
 
-void check_claims(
+bool check_claims(
         const goto_modelt & goto_model,
         claim_checkmapt & claim_checkmap,
         claim_numberst & claim_numbers,
         optionst & options,
         ui_message_handlert & _message_handler,
-        unsigned claim_user_nr)
+        unsigned claim_user_nr,
+        unwind_boundst * unwind_bounds)
 {
   // precondition: the leaping program must be numbered correctly.
   claim_statst res {options.get_unsigned_int_option("unwind")};
@@ -158,18 +165,19 @@ void check_claims(
     if (ass_ptr == main_body.instructions.end()){
       if (seen_claims == 0) // In case we set the multi assert mode working here
         res.status() << "\nAssertion is not reachable\n" << res.eom;
-      return;
+      return false;
     }
 
     theory_refinert th_checker(main_body,
 	        goto_functions, goto_model.symbol_table, options, _message_handler);
 
     th_checker.initialize();
-    th_checker.assertion_holds_smt(assertion_infot{ass_ptr}, true);
-    return;
+    claim_checkmap[ass_ptr] = std::make_pair(true, th_checker.assertion_holds_smt(assertion_infot{ass_ptr}, true));
+    return true;
   }
 
   core_checkert core_checker(goto_model, options, _message_handler, res.max_mem_used);
+  core_checker.set_unwind_bounds(unwind_bounds);
 //init function nodes from nil to an ID, all funcs are initialized to use summaries if any (ALL_SUBSTITUTING)
     core_checker.initialize_call_info();
   
@@ -177,7 +185,7 @@ void check_claims(
   if (options.get_bool_option("bootstrapping")){
     messaget msg{_message_handler};
     check_initial(core_checker, msg);
-    return;
+    return true;
   }
 
 #ifdef PRODUCE_PROOF
@@ -236,12 +244,35 @@ void check_claims(
           res.status() <<res.eom;
       }
       res.status()<<"Finally w.r.t all assertions, the program is "<<(finally_safe ? "SAFE\n" : "UNSAFE\n")<<res.eom;
-      return;
+      return core_checker.is_loop_bound_reached();
   }
 #endif
 
   if (options.get_bool_option("all-claims") || options.get_bool_option("claims-opt")){
     core_checker.assertion_holds(assertion_infot(), true);
+  } else if (options.get_bool_option("shared-symex") && !multi_assert && claim_user_nr == 0) {
+    if(!assert_grouping){
+      res.warning() << "Assertion grouping cannot be disabled in current mode!\n" << res.eom;
+      assert_grouping = true;
+    }
+    std::vector<goto_programt::const_targett> shared_claims;
+    while((ass_ptr = res.find_assertion(ass_ptr, goto_functions, stack)) != main_body.instructions.end()){
+      if (!claim_checkmap[ass_ptr].first) {
+        claim_checkmap[ass_ptr].first = true;
+        shared_claims.push_back(ass_ptr);
+      }
+    }
+    if (shared_claims.empty()) {
+      res.status() << "\nAssertion is not reachable\n" << res.eom;
+      return false;
+    }
+    res.status() << "\r  Checking " << shared_claims.size() << " claim(s) on a shared SSA form ..." << res.eom;
+    const auto violated = core_checker.claims_hold_shared(shared_claims);
+    for (const auto & claim : shared_claims) {
+      claim_checkmap[claim].second = violated.count(claim) == 0;
+      res.status() << "Claim number # " << claim_numbers[claim] << " is "
+                   << (violated.count(claim) == 0 ? "SAFE" : "UNSAFE") << res.eom;
+    }
   } else while(true) {
     // Next assertion (or next occurrence of the same assertion)
     ass_ptr = res.find_assertion(ass_ptr, goto_functions, stack);
@@ -276,9 +307,12 @@ void check_claims(
           break;
         }
       }
-      if (ok){
-        multi_assert_loc.push_back(ass_ptr);
+      if (!ok){
+        continue; // not checked at all
       }
+      multi_assert_loc.push_back(ass_ptr);
+      // known once all the selected claims are checked together
+      pass = true;
     } else { //normal hifrog
       pass = core_checker.assertion_holds(assert_grouping ?
               assertion_infot(ass_ptr) : assertion_infot(stack, ass_ptr), false);
@@ -305,8 +339,179 @@ void check_claims(
       }
     }
     res.status() << " in a multi_assertion mode.\r" << res.eom;
-    core_checker.assertion_holds(assert_grouping ?
+    const bool pass = core_checker.assertion_holds(assert_grouping ?
                   assertion_infot(multi_assert_loc) : assertion_infot(stack, ass_ptr), false);
+    for (const auto & loc : multi_assert_loc) {
+      claim_checkmap[loc].second = pass;
+    }
+  }
+  return core_checker.is_loop_bound_reached();
+}
+
+/*******************************************************************\
+
+Function: parse_unwind_deepening
+
+  Inputs: the value of --unwind-deepening
+
+ Outputs: false if it is not min:max:step with 0 < min <= max and step > 0
+
+\*******************************************************************/
+
+bool parse_unwind_deepening(const std::string & value, unsigned & min_bound,
+                              unsigned & max_bound, unsigned & step)
+{
+  std::vector<unsigned> values;
+  std::string::size_type start = 0;
+  for (std::string::size_type next; (next = value.find(':', start)) != std::string::npos; start = next + 1) {
+    values.push_back(unsafe_string2unsigned(value.substr(start, next - start)));
+  }
+  values.push_back(unsafe_string2unsigned(value.substr(start)));
+  if (values.size() != 3 || values[0] == 0 || values[2] == 0 || values[0] > values[1]) {
+    return false;
+  }
+  min_bound = values[0];
+  max_bound = values[1];
+  step = values[2];
+  return true;
+}
+
+/*******************************************************************\
+
+Function: check_claims_deepening
+
+  Inputs: the unwind bounds in the form min:max:step
+
+ Outputs:
+
+ Purpose: Iterative deepening: checks the claims with increasing unwind
+ bounds until a claim fails, no loop is cut by the bound or the maximal
+ bound is reached. Every bound is checked from scratch, nothing of the
+ previous bounds is reused: not the SSA form, not the solver and not the
+ summaries, which hold only for the loops cut by their bound.
+
+\*******************************************************************/
+
+void check_claims_deepening(
+        const goto_modelt & goto_model,
+        claim_checkmapt & claim_checkmap,
+        claim_numberst & claim_numbers,
+        optionst & options,
+        ui_message_handlert & _message_handler,
+        unsigned claim_user_nr)
+{
+  messaget msg{_message_handler};
+  unsigned min_bound = 0;
+  unsigned max_bound = 0;
+  unsigned step = 0;
+  // checked by parser_baset::validate_input_options
+  const bool valid = parse_unwind_deepening(options.get_option("unwind-deepening"), min_bound, max_bound, step);
+  assert(valid);
+  (void)valid;
+
+  for (unsigned bound = min_bound; ; bound += step) {
+    options.set_option("unwind", bound);
+    for (auto & claim : claim_checkmap) {
+      claim.second = std::make_pair(false, true);
+    }
+    msg.status() << "\n--- Unwind bound " << bound << " ---" << msg.eom;
+    bool bound_reached = check_claims(goto_model, claim_checkmap, claim_numbers, options,
+                                      _message_handler, claim_user_nr);
+
+    bool failed = std::any_of(claim_checkmap.begin(), claim_checkmap.end(),
+                              [](const claim_checkmapt::value_type & claim) {
+                                return claim.second.first && !claim.second.second;
+                              });
+    if (failed) {
+      msg.status() << "A claim fails with unwind bound " << bound << msg.eom;
+      return;
+    }
+    if (!bound_reached) {
+      msg.status() << "No loop reaches unwind bound " << bound
+                   << ", the result holds for any larger bound" << msg.eom;
+      return;
+    }
+    if (bound >= max_bound || max_bound - bound < step) {
+      msg.status() << "Maximal unwind bound " << bound << " reached, loops may be cut" << msg.eom;
+      return;
+    }
+    // the summaries of this bound hold only for the cut loops
+    options.set_option("load-summaries", "");
+  }
+}
+
+
+/*******************************************************************\
+
+Function: check_claims_auto
+
+  Inputs: the maximal unwind bound of a loop
+
+ Outputs:
+
+ Purpose: Automatic unwinding: the loops start with the unwind bound and
+ only the bounds of the loops reachable after their last unwinding are
+ raised, until a claim fails, no loop is cut or the maximal bound is
+ reached. The recursion is unwound by the refinement; the found bounds
+ and depths are loaded from and stored next to the summaries.
+
+\*******************************************************************/
+
+void check_claims_auto(
+        const goto_modelt & goto_model,
+        claim_checkmapt & claim_checkmap,
+        claim_numberst & claim_numbers,
+        optionst & options,
+        ui_message_handlert & _message_handler,
+        unsigned claim_user_nr)
+{
+  messaget msg{_message_handler};
+  // checked by parser_baset::validate_input_options
+  const unsigned max_bound = options.get_unsigned_int_option("unwind-auto");
+  assert(max_bound > 0);
+  unwind_boundst unwind_bounds{options.get_unsigned_int_option("unwind")};
+
+  for (const auto & summary_file : splitString(options.get_option("load-summaries"), ',')) {
+    std::ifstream in(summary_file + "_unwind");
+    if (in.good()) {
+      unwind_bounds.deserialize(in);
+    }
+  }
+  const std::string & summary_file = options.get_option("save-summaries");
+
+  for (unsigned round = 1; ; ++round) {
+    for (auto & claim : claim_checkmap) {
+      claim.second = std::make_pair(false, true);
+    }
+    msg.status() << "\n--- Automatic unwinding, round " << round << " ---" << msg.eom;
+    check_claims(goto_model, claim_checkmap, claim_numbers, options, _message_handler, claim_user_nr,
+                 &unwind_bounds);
+    const bool bound_reached = unwind_bounds.has_exceeded_loops();
+    const unsigned raised = unwind_bounds.raise_exceeded_bounds(max_bound);
+    if (!summary_file.empty()) {
+      std::ofstream out(summary_file + "_unwind");
+      unwind_bounds.serialize(out);
+    }
+
+    bool failed = std::any_of(claim_checkmap.begin(), claim_checkmap.end(),
+                              [](const claim_checkmapt::value_type & claim) {
+                                return claim.second.first && !claim.second.second;
+                              });
+    if (failed) {
+      msg.status() << "A claim fails in round " << round << " of the automatic unwinding" << msg.eom;
+      return;
+    }
+    if (!bound_reached) {
+      msg.status() << "No loop reaches its unwind bound, the result holds for any larger bound" << msg.eom;
+      return;
+    }
+    if (raised == 0) {
+      msg.status() << "Maximal unwind bound " << max_bound << " reached, loops may be cut" << msg.eom;
+      return;
+    }
+    msg.status() << "Raised the unwind bound of " << raised << " loop(s)" << msg.eom;
+    // the summaries of this round hold only for the cut loops
+    options.set_option("load-summaries", "");
   }
 }
 
@@ -16,6 +16,8 @@
 #include "unwind.h"
 #include "funfrog/call_stack.h"
 
+class unwind_boundst;
+
 class claim_statst:public messaget, public unwindt
 {
 
@@ -63,7 +65,31 @@ void get_claims(const goto_functionst &goto_functions,
 void store_claims(const claim_checkmapt &claim_checkmap,
     const claim_numberst &claim_numbers);
 
-void check_claims(
+bool check_claims(
+        const goto_modelt & goto_model,
+        claim_checkmapt & claim_checkmap,
+        claim_numberst & claim_numbers,
+        optionst & options,
+        ui_message_handlert & _message_handler,
+        unsigned claim_user_nr = 0,
+        unwind_boundst * unwind_bounds = nullptr);
+
+// False if the value of --unwind-deepening is not min:max:step with 0 < min <= max and step > 0
+bool parse_unwind_deepening(const std::string & value, unsigned & min_bound,
+                              unsigned & max_bound, unsigned & step);
+
+// Repeats check_claims with the unwind bounds given by --unwind-deepening,
+// each bound from scratch (iterative deepening, not incremental BMC)
+void check_claims_deepening(
+        const goto_modelt & goto_model,
+        claim_checkmapt & claim_checkmap,
+        claim_numberst & claim_numbers,
+        optionst & options,
+        ui_message_handlert & _message_handler,
+        unsigned claim_user_nr = 0);
+
+// Repeats check_claims raising the unwind bounds of the loops cut by them (--unwind-auto)
+void check_claims_auto(
         const goto_modelt & goto_model,
         claim_checkmapt & claim_checkmap,
         claim_numberst & claim_numbers,
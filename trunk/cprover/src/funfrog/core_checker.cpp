@@ -23,6 +23,8 @@
 #include "prop_summary_store.h"     // OpenSMT prop store
 #include "partitioning_slice.h"
 #include "refiner_assertion_sum.h"
+#include "interval_invariants.h"
+#include "utils/SummaryInvalidException.h"
 //#include "utils/unsupported_operations.h"
 
 #ifdef Z3_AVAILABLE
@@ -36,6 +38,7 @@
 //#include <goto-symex/path_storage.h>
 #include <stdio.h>
 #include <memory>
+#include <algorithm>
 
 
 /*******************************************************************
@@ -62,6 +65,24 @@ core_checkert::~core_checkert(){
     //delete decider;
 }
 
+/*******************************************************************
+ Function: core_checkert::get_invariants
+
+ Purpose: Runs the interval analysis of the program once, if requested
+\*******************************************************************/
+const interval_invariantst * core_checkert::get_invariants() {
+    if (!options.get_bool_option("interval-invariants")) {
+        return nullptr;
+    }
+    if (!invariants) {
+        auto before = timestamp();
+        invariants.reset(new interval_invariantst(get_goto_functions(), ns));
+        auto after = timestamp();
+        statistics() << "INVARIANTS TIME: " << time_gap(after,before) << eom;
+    }
+    return invariants.get();
+}
+
 void core_checkert::init_solver_and_summary_store() {
     initialize_solver();
     initialize_summary_store();
@@ -380,6 +401,7 @@ void core_checkert::initialize_solver_options()
         solver_options.m_reduction_loops = options.get_unsigned_int_option("reduce-proof-loops");
         solver_options.m_reduction_graph = options.get_unsigned_int_option("reduce-proof-graph");
     }
+    solver_options.m_minimize_summaries = options.get_bool_option("minimize-summaries");
 #endif 
 }
 /*******************************************************************
@@ -392,6 +414,7 @@ void core_checkert::initialize_call_info()
   // Prepare summary_info (encapsulated in omega), start with the lazy variant,
   // i.e., all summaries are initialized as HAVOC, except those on the way
   // to the target assertion, which are marked depending on initial mode.
+      omega.set_lazy_expansion(options.get_bool_option("lazy-call-tree"));
       omega.initialize_call_info (omega.get_call_tree_root(), get_main_function());
       //omega.process_goto_locations();
       init = get_init_mode(options.get_option("init-mode"));
@@ -451,12 +474,30 @@ bool core_checkert::assertion_holds(const assertion_infot& assertion,
     else { //bootstrapping or normal BMC check
         init_solver_and_summary_store();
     }
-    const auto & const_summary_store = *summary_store;
+    // omega keeps the predicates for the lazily expanded nodes, they must not refer to locals
+    std::shared_ptr<const summary_storet> const_summary_store = summary_store;
     bool nopartitions = options.get_bool_option("no-partitions"); //no-summary in no-partitioning
-    auto has_summary = [&const_summary_store, nopartitions](const std::string & function_name){
-        return nopartitions ? false : const_summary_store.function_has_summaries(function_name);
+    auto has_summary = [const_summary_store, nopartitions](const std::string & function_name){
+        return nopartitions ? false : const_summary_store->function_has_summaries(function_name);
     };
-    omega.set_initial_precision(assertion, has_summary);
+    // summaries computed at one call site are reused at the other call sites of the function;
+    // not in UpProver, which keeps one summary per call tree node
+    auto find_summary = [const_summary_store](const call_tree_nodet & node){
+        return const_summary_store->find_context_summary(node.get_function_id().c_str(),
+                                                        node.get_call_site_signature(),
+                                                        node.get_calling_context_hash());
+    };
+    if (options.get_bool_option("summary-validation")) {
+        omega.set_initial_precision(assertion, has_summary);
+    }
+    else {
+        omega.set_initial_precision(assertion, has_summary, find_summary);
+#ifdef PRODUCE_PROOF
+        if (options.get_bool_option("outline-loops")) {
+            use_loop_invariants();
+        }
+#endif
+    }
   if (nopartitions) // BMC alike version
     return assertion_holds_smt_no_partition(assertion);
   else
@@ -483,6 +524,9 @@ bool core_checkert::assertion_holds_smt(const assertion_infot &assertion,
 
     partitioning_target_equationt equation(ns, *summary_store,
                                                 store_summaries_with_assertion);
+    // the converted SSA steps are released; the error trace is built from a new run
+    const bool low_memory = options.get_bool_option("low-memory");
+    equation.set_low_memory(low_memory);
 
 #ifdef DISABLE_OPTIMIZATIONS
     if (options.get_bool_option("dump-SSA-tree")) {
@@ -505,20 +549,45 @@ bool core_checkert::assertion_holds_smt(const assertion_infot &assertion,
                                                       options.get_bool_option("partial-loops")
                                 };
     symex.set_assertion_info_to_verify(&assertion);
+    symex.set_unwind_bounds(unwind_bounds);
+    symex.set_invariants(get_invariants());
 
     refiner_assertion_sumt refiner {
               *summary_store, omega,
               get_refine_mode(options.get_option("refine-mode")),
               message_handler, last_assertion_loc};//, true};
 
+    formula_managert ssa_to_formula = formula_managert(equation, message_handler);
+    if (options.get_bool_option("replay-cex")) {
+        ssa_to_formula.set_replay_program(get_goto_functions(), goto_model.symbol_table);
+    }
+    // Convert the partitions while symex generates the rest; the steps must
+    // not change after symex (slicing is off here, the claims optimization is not)
+    bool stream_conversion = options.get_bool_option("stream-conversion")
+                             && !options.get_bool_option("claims-opt");
+#ifndef IREP_THREAD_SAFE
+    if (stream_conversion) {
+        warning() << "Streaming conversion needs a build with thread-safe ireps;"
+                  << " converting after symex" << eom;
+        stream_conversion = false;
+    }
+#endif
+    if (stream_conversion) {
+        ssa_to_formula.start_streaming_conversion(*(decider->get_convertor()), *(decider->get_interpolating_solver()));
+    }
     bool assertion_holds = prepareSSA(symex);
+    bool converted = false;
+    if (stream_conversion) {
+        ssa_to_formula.finish_streaming_conversion(*(decider->get_convertor()), *(decider->get_interpolating_solver()));
+        converted = true;
+    }
     if(!assertion_holds && options.get_bool_option("claims-opt")){
         dependency_checkert(ns,
                     message_handler, 
                     get_main_function(),
                     omega, 
                     options.get_unsigned_int_option("claims-opt"), 
-                    equation.SSA_steps.size())
+                    equation.get_SSA_steps_count())
                 .do_it(equation);
         status() << (std::string("Ignored SSA steps after dependency checker: ") + std::to_string(equation.count_ignored_SSA_steps())) << eom;
     }
@@ -526,13 +595,18 @@ bool core_checkert::assertion_holds_smt(const assertion_infot &assertion,
     // the checker main loop:
     unsigned summaries_used = 0;
     unsigned iteration_counter = 0;
-    formula_managert ssa_to_formula = formula_managert(equation, message_handler);
     auto solver = decider->get_solver();
     while (!assertion_holds) {
         iteration_counter++;
 
-        //Converts SSA to SMT formula
-        ssa_to_formula.convert_to_formula( *(decider->get_convertor()), *(decider->get_interpolating_solver()));
+        //Converts SSA to SMT formula (the first time already done if streaming)
+        if (!converted) {
+            ssa_to_formula.convert_to_formula( *(decider->get_convertor()), *(decider->get_interpolating_solver()));
+        }
+        converted = false;
+        if (low_memory) {
+            statistics() << "Released SSA steps: " << equation.release_converted_steps(*(decider->get_convertor())) << eom;
+        }
 
         // Decides the equation
         bool is_sat = ssa_to_formula.is_satisfiable(*solver);
@@ -571,7 +645,14 @@ bool core_checkert::assertion_holds_smt(const assertion_infot &assertion,
                 for (auto const & refined_node : refined_functions ){
                     if (refined_node->node_has_summary()) {
                         const summary_idt smID = refined_node->get_node_sumID();
-                        summary_store->remove_summary(smID);
+                        // the summary might be shared with other call sites (see find_context_summary)
+                        const auto & nodes = omega.get_call_summaries();
+                        bool shared = std::any_of(nodes.begin(), nodes.end(), [refined_node, smID](const call_tree_nodet * node) {
+                            return node != refined_node && node->get_node_sumID() == smID;
+                        });
+                        if (!shared) {
+                            summary_store->remove_summary(smID);
+                        }
                         refined_node->remove_node_sumID(smID);
                         //notify partitions about removal of summaries
                         //equation.refine_partition(entry_partition.get_iface().partition_id);
@@ -627,7 +708,12 @@ bool core_checkert::assertion_holds_smt(const assertion_infot &assertion,
     } // End of UNSAT section
     else // assertion was falsified
     {
-        assertion_violated(ssa_to_formula, symex.guard_expln);
+        if (low_memory && !options.get_bool_option("no-error-trace")) {
+            assertion_violated_regenerated(assertion, store_summaries_with_assertion);
+        }
+        else {
+            assertion_violated(ssa_to_formula, symex.guard_expln);
+        }
     }
     // FINAL REPORT
 
@@ -662,6 +748,162 @@ bool core_checkert::assertion_holds_smt(const assertion_infot &assertion,
   
 }
   
+/*******************************************************************
+ Function: core_checkert::claims_hold_shared
+
+ Purpose: Checks all the given claims with one symex run and one
+ conversion: the assertions are guarded by selector literals and every
+ claim found violated is switched off for the next solver call (by a
+ unit clause, OpenSMT has no solving under assumptions here).
+ Without summaries and havocked calls the model is exact: each claim it
+ violates is reported with an error trace built from that model.
+ Otherwise the violated claims need refinement and are checked again
+ one by one.
+\*******************************************************************/
+std::set<goto_programt::const_targett> core_checkert::claims_hold_shared(
+        const std::vector<goto_programt::const_targett> & claims)
+{
+    options.set_option("no-slicing", true);
+    auto before = timestamp();
+
+    init_solver_and_summary_store();
+    std::shared_ptr<const summary_storet> const_summary_store = summary_store;
+    auto has_summary = [const_summary_store](const std::string & function_name){
+        return const_summary_store->function_has_summaries(function_name);
+    };
+    auto find_summary = [const_summary_store](const call_tree_nodet & node){
+        return const_summary_store->find_context_summary(node.get_function_id().c_str(),
+                                                        node.get_call_site_signature(),
+                                                        node.get_calling_context_hash());
+    };
+    const assertion_infot all_assertions(claims);
+    omega.set_initial_precision(all_assertions, has_summary, find_summary);
+
+    partitioning_target_equationt equation(ns, *summary_store, false);
+    equation.set_claim_selection(true);
+
+    std::unique_ptr<path_storaget> worklist;
+    symex_assertion_sumt symex { get_goto_functions(), omega.get_call_tree_root(), options, *worklist,
+                                 ns.get_symbol_table(), equation,
+                                 message_handler, get_main_function(), omega.get_last_assertion_loc(),
+                                 omega.is_single_assertion_check(),
+                                 !options.get_bool_option(HiFrogOptions::NO_ERROR_TRACE),
+                                 options.get_unsigned_int_option(HiFrogOptions::UNWIND),
+                                 options.get_bool_option("partial-loops")
+                               };
+    symex.set_assertion_info_to_verify(&all_assertions);
+    symex.set_unwind_bounds(unwind_bounds);
+    symex.set_invariants(get_invariants());
+
+    std::set<goto_programt::const_targett> violated;
+    std::vector<goto_programt::const_targett> to_recheck;
+    unsigned solver_calls = 0;
+    // nothing to refine, as in assertion_holds
+    const bool exact = omega.get_summaries_count() == 0 && omega.get_nondets_count() == 0;
+    if (!prepareSSA(symex)) {
+        formula_managert ssa_to_formula(equation, message_handler);
+        if (options.get_bool_option("replay-cex")) {
+            ssa_to_formula.set_replay_program(get_goto_functions(), goto_model.symbol_table);
+        }
+        auto convertor = decider->get_convertor();
+        auto interpolator = decider->get_interpolating_solver();
+        auto solver = decider->get_solver();
+        ssa_to_formula.convert_to_formula(*convertor, *interpolator);
+
+        while (ssa_to_formula.is_satisfiable(*solver)) {
+            ++solver_calls;
+            const auto failed = equation.get_violated_claims(*solver);
+            if (failed.empty()) {
+                // cannot happen unless the encoding is broken; do not loop forever
+                warning() << "WARNING: a model without a violated claim" << eom;
+                break;
+            }
+            status() << "Violated claims in this model: " << failed.size() << eom;
+            for (const auto & claim : failed) {
+                if (exact) {
+                    violated.insert(claim);
+                    ssa_to_formula.set_error_trace_claim(claim);
+                    assertion_violated(ssa_to_formula, symex.guard_expln);
+                }
+                else {
+                    to_recheck.push_back(claim);
+                }
+            }
+            for (const auto & claim : failed) {
+                equation.disable_claim(*convertor, *interpolator, claim);
+            }
+        }
+        ++solver_calls;
+
+#ifdef PRODUCE_PROOF
+        // the remaining claims hold; the summaries do not depend on the selectors
+        if (!options.get_bool_option("no-itp") && interpolator->can_interpolate()) {
+            status() << ("Start generating interpolants...") << eom;
+            extract_interpolants(equation);
+        }
+#endif
+    }
+
+    status() << "Shared symex: " << claims.size() << " claim(s), " << solver_calls << " solver call(s), "
+             << violated.size() << " claim(s) violated, "
+             << to_recheck.size() << " claim(s) to be checked separately" << eom;
+    auto after = timestamp();
+    status() << "TOTAL TIME FOR CHECKING THE SHARED EQUATION: " << time_gap(after,before) << eom;
+
+    for (const auto & claim : to_recheck) {
+        if (!assertion_holds(assertion_infot(claim), false)) {
+            violated.insert(claim);
+        }
+    }
+    if (violated.empty()) {
+        report_success();
+    }
+    return violated;
+}
+
+/*******************************************************************
+ Function: core_checkert::assertion_violated_regenerated
+
+ Purpose: Prints the error trace for smt encoding in the low-memory mode,
+ where the steps of the checked equation have been released: symex and
+ the solver are run again on the final precision of the call tree, with
+ the steps kept this time.
+\*******************************************************************/
+void core_checkert::assertion_violated_regenerated(const assertion_infot &assertion,
+                                                   bool store_summaries_with_assertion)
+{
+    status() << "Generating the SSA form again for the error trace" << eom;
+    // the old solver holds the formula of the released steps
+    initialize_solver();
+
+    partitioning_target_equationt equation(ns, *summary_store,
+                                           store_summaries_with_assertion);
+    std::unique_ptr<path_storaget> worklist;
+    symex_assertion_sumt symex { get_goto_functions(), omega.get_call_tree_root(), options, *worklist,
+                                 ns.get_symbol_table(), equation,
+                                 message_handler, get_main_function(), omega.get_last_assertion_loc(),
+                                 omega.is_single_assertion_check(), true,
+                                 options.get_unsigned_int_option(HiFrogOptions::UNWIND),
+                                 options.get_bool_option("partial-loops")
+                               };
+    symex.set_assertion_info_to_verify(&assertion);
+    symex.set_unwind_bounds(unwind_bounds);
+    symex.set_invariants(get_invariants());
+    prepareSSA(symex);
+
+    formula_managert ssa_to_formula(equation, message_handler);
+    if (options.get_bool_option("replay-cex")) {
+        ssa_to_formula.set_replay_program(get_goto_functions(), goto_model.symbol_table);
+    }
+    ssa_to_formula.convert_to_formula(*(decider->get_convertor()), *(decider->get_interpolating_solver()));
+    if (!ssa_to_formula.is_satisfiable(*(decider->get_solver()))) {
+        warning() << "WARNING: the counterexample could not be reproduced, no error trace" << eom;
+        report_failure();
+        return;
+    }
+    assertion_violated(ssa_to_formula, symex.guard_expln);
+}
+
 /*******************************************************************
  Function: core_checkert::assertion_violated
 
@@ -674,8 +916,8 @@ void core_checkert::assertion_violated (formula_managert& prop,
     {
         solvert* solver = decider->get_solver();
         assert(solver);
-        prop.error_trace(*decider, ns, guard_expln);
-        if (solver->is_overapprox_encoding()){
+        bool reproduced = prop.error_trace(*decider, ns, guard_expln);
+        if (solver->is_overapprox_encoding() && !reproduced){
             status() << "\nA bug found." << eom;
             status() << "WARNING: Possibly due to the Theory conversion." << eom;
         } else {
@@ -688,6 +930,107 @@ void core_checkert::assertion_violated (formula_managert& prop,
 
 
 #ifdef PRODUCE_PROOF
+/*******************************************************************\
+ Function: core_checkert::use_loop_invariants
+
+ Purpose: The recursive calls of the outlined loops are havocked; where
+ a summary of the loop is inductive, it is used there instead, so it
+ holds for any number of iterations
+\*******************************************************************/
+void core_checkert::use_loop_invariants()
+{
+    if (!summary_store || !decider->get_interpolating_solver()->can_interpolate()) {
+        return;
+    }
+    std::map<summary_idt, bool> inductive;
+    unsigned used = 0;
+    for (call_tree_nodet * node : omega.get_call_summaries()) {
+        const std::string function_name = node->get_function_id().c_str();
+        if (!node->is_recursion_nondet() || node->get_precision() != HAVOC || !is_outlined_loop(function_name)
+            || !summary_store->function_has_summaries(function_name)) {
+            continue;
+        }
+        // the loop called by itself: the parent is the loop, with the recursive call as the last iteration
+        call_tree_nodet & loop_node = node->get_parent();
+        if (loop_node.get_function_id() != node->get_function_id() || loop_node.get_precision() == HAVOC
+            || loop_node.has_assertion_in_subtree()) {
+            continue;
+        }
+        for (summary_idt id : summary_store->get_summariesID(function_name)) {
+            auto it = inductive.find(id);
+            if (it == inductive.end()) {
+                it = inductive.emplace(id, is_inductive_loop_summary(loop_node, *node, id)).first;
+            }
+            if (it->second) {
+                node->add_node_sumID(id);
+                node->set_summary();
+                ++used;
+                break;
+            }
+        }
+    }
+    if (!inductive.empty()) {
+        // the solver is used for the claim next
+        decider->get_solver()->reset_solver();
+        status() << "Inductive loop summaries: "
+                 << std::count_if(inductive.begin(), inductive.end(),
+                                  [](const std::pair<const summary_idt, bool> & entry) { return entry.second; })
+                 << " of " << inductive.size() << ", used at " << used << " recursive call(s)" << eom;
+    }
+}
+
+/*******************************************************************\
+ Function: core_checkert::is_inductive_loop_summary
+
+ Purpose: Checks whether the loop with the summary at its recursive
+ call implies the summary; the recursive call keeps the summary if so
+\*******************************************************************/
+bool core_checkert::is_inductive_loop_summary(call_tree_nodet & loop_node, call_tree_nodet & recursive_call,
+                                              summary_idt summary_id)
+{
+    decider->get_solver()->reset_solver();
+    const auto loop_precision = loop_node.get_precision();
+    recursive_call.add_node_sumID(summary_id);
+    recursive_call.set_summary();
+
+    partitioning_target_equationt equation(ns, *summary_store, false);
+    std::unique_ptr<path_storaget> worklist;
+    symex_assertion_sumt symex{get_goto_functions(), loop_node, options, *worklist,
+                               ns.get_symbol_table(), equation, message_handler,
+                               get_goto_functions().function_map.at(loop_node.get_function_id()).body,
+                               omega.get_last_assertion_loc(), omega.is_single_assertion_check(), false,
+                               options.get_unsigned_int_option(HiFrogOptions::UNWIND),
+                               options.get_bool_option("partial-loops")
+                              };
+    // no assertion: only the negated summary is to be refuted
+    const assertion_infot no_assertion{std::vector<goto_programt::const_targett>()};
+    symex.set_assertion_info_to_verify(&no_assertion);
+    symex.set_unwind_bounds(unwind_bounds);
+    // not prepareSSA: nothing to slice for, and the bounds reached here do not concern the claim
+    symex.prepare_SSA();
+
+    bool inductive = false;
+    auto interpolator = decider->get_interpolating_solver();
+    interpolator->new_partition();
+    try {
+        interpolator->substitute_negate_insert(summary_store->find_summary(summary_id),
+                                               equation.get_partitions()[0].get_iface().get_iface_symbols());
+        formula_managert formula_manager{equation, message_handler};
+        formula_manager.convert_to_formula(*(decider->get_convertor()), *interpolator);
+        inductive = !formula_manager.is_satisfiable(*(decider->get_solver()));
+    }
+    catch (SummaryInvalidException &) {
+        // the summary does not fit the interface of the loop
+    }
+
+    loop_node.set_precision(loop_precision);
+    if (!inductive) {
+        recursive_call.remove_node_sumID(summary_id);
+        recursive_call.set_nondet();
+    }
+    return inductive;
+}
+
 /*******************************************************************\
  Function: core_checkert::extract_interpolants_smt
 
@@ -799,88 +1142,26 @@ Purpose: extracts summaries after successful verification; and dumps the summari
 /*******************************************************************\
  Function: reload_summaries
 
- Purpose: LPAR 2018 paper
+ Purpose: LPAR 2018 paper; the summaries of the previous solver are
+ given to the decider, with the terms it cannot read (non-linear or
+ unsupported operations) abstracted on the terms of the previous solver
 \*******************************************************************/
-    void reload_summaries(const namespacet &ns,
-                          smt_summary_storet & store, std::vector<std::string> const & filenames,
+    void reload_summaries(smt_summary_storet & store, std::vector<std::string> const & filenames,
                           smtcheck_opensmt2t_lra & decider, smtcheck_opensmt2t_uf & prev_solver) {
 
-        // Put the whole summary file in string
-        std::stringstream dump;
-        dump << decider.getSimpleHeader();  // gets all the declarations without the variables
-        store.serialize(dump);
-        std::string sm = dump.str();
-
-        // Detect unsupported functions
-        std::vector<std::string> unsupp_func = get_unsupported_funct_exprs(sm);
-
-        // Detect if there are non-linear parts (searching for non-linear / or *):
-        std::set<PTRef> non_linears = prev_solver.get_non_linears();
-        if (non_linears.size() > 0 || !unsupp_func.empty())
+        // the fresh variables are declared in the previous solver, so they are in its header
+        const std::size_t abstracted = store.abstract_non_linears();
+        if (abstracted > 0)
         {
-            const Logic& logic = *prev_solver.getLogic();
-            std::transform(non_linears.begin(), non_linears.end(), std::back_inserter(unsupp_func),
-                           [&logic](PTRef pt){ return std::string{logic.printTerm(pt)};});
             // Notify the user
-            std::cerr << "Non linear operation encounter. Ignoring " << non_linears.size() << " expressions in the file.\n";
-
-            std::sort(unsupp_func.begin(), unsupp_func.end(), [](const std::string & first, const std::string & second){
-                return first.size() > second.size();
-            });
-
-            // Replace all non-linear expressions in unsupported variable
-            for(auto old_token : unsupp_func)
-            {
-                // Get the old token we wish to abstract
-                std::string new_token = fresh_var_name_nonlinear();
-                prev_solver.getLogic()->mkVar(prev_solver.get_numeric_sort(), new_token.c_str());
-                // New Unsupported Var with no specific mapping or information saved
-
-                // The symbol name in the old token
-                std::string::size_type n_before = 0;
-                std::string::size_type n_after = 0;
-                while ( ( n_before = old_token.find( "|", n_after) ) != std::string::npos )
-                {
-                    if (( n_after = old_token.find( "|", n_before+1) ) != std::string::npos)
-                    {
-                        // Get SSA names in the old token
-                        std::string id_str_SSA = old_token.substr( n_before+1, n_after-n_before-1);
-                        std::string id_str_curr = id_str_SSA;
-                        irep_idt identifier = id_str_curr;
-
-                        // Get the symbol name of the SSA name:
-                        const symbolt *symbol =0;
-                        while (ns.lookup(identifier, symbol) && id_str_curr.size()>0)
-                        {
-                            id_str_curr = id_str_curr.substr(0,id_str_curr.size()-1);
-                            identifier = id_str_curr;
-                        }
-    //                        std::cout << "** Replace : " << id_str_SSA << " in " << id_str_curr << std::endl;
-
-                        // Fix the old token to use symbols and not SSAs
-                        old_token.replace( n_before+1, id_str_SSA.size(), id_str_curr );
-                        n_before = old_token.find(id_str_curr, n_before) + id_str_curr.size()+1;
-                        n_after = n_before;
-                    } else {
-                        break;
-                    }
-                }
-
-                // Create the abstract summary:
-                std::string::size_type n = 0;
-                while ( ( n = sm.find( old_token, n ) ) != std::string::npos )
-                {
-                    sm.replace( n, old_token.size(), new_token );
-                    n += new_token.size();
-                }
-    //              std::cout << "Replacing " << old_token << " in " << new_token << std::endl;
-            }
+            std::cerr << "Non linear operation encounter. Ignoring " << abstracted << " expressions in the summaries.\n";
 
             // Store to Temp. file
             std::ofstream out;
             out.open("__summaries_linear_temp");
             //dumps define-fun()  into summary file
-            out << prev_solver.getSimpleHeader() << sm;
+            out << prev_solver.getSimpleHeader() << decider.getSimpleHeader();
+            store.serialize(out);
             out.close();
 
             std::vector<std::string> filenames_linear;
@@ -956,14 +1237,16 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
     auto & uf_solver = *uf_solver_ptr;
 
 
-    smt_summary_storet summary_store {uf_solver_ptr.get()};
+    // shared with the predicate kept by omega for the lazily expanded nodes
+    auto summary_store_ptr = std::make_shared<smt_summary_storet>(uf_solver_ptr.get());
+    auto & summary_store = *summary_store_ptr;
     //reading summary by uf
     status() << "\n--Reading UF summary file: " << uf_summary_file_name << eom;
     summary_store.deserialize({uf_summary_file_name});
-    const auto & const_summary_store = summary_store;
-    auto has_summary = [&const_summary_store]
+    std::shared_ptr<const summary_storet> const_summary_store = summary_store_ptr;
+    auto has_summary = [const_summary_store]
             (const std::string & function_name){
-        return const_summary_store.function_has_summaries(function_name);
+        return const_summary_store->function_has_summaries(function_name);
     };
     omega.set_initial_precision(assertion, has_summary);
     std::unique_ptr<path_storaget> worklist;
@@ -984,6 +1267,8 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
                                options.get_bool_option("partial-loops")
     };
     symex.set_assertion_info_to_verify(&assertion);
+    symex.set_unwind_bounds(unwind_bounds);
+    symex.set_invariants(get_invariants());
 
     bool assertion_holds = prepareSSA(symex);
     if (assertion_holds){
@@ -994,6 +1279,14 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
         return true;
     }
 
+    // before escalating to a more precise logic, check if the counterexample is real anyway
+    auto is_cex_reproducible = [&](ssa_solvert & solver){
+        if (!options.get_bool_option("replay-cex")) { return false; }
+        formula_managert cex_formula {equation, message_handler};
+        cex_formula.set_replay_program(get_goto_functions(), goto_model.symbol_table);
+        return cex_formula.is_cex_reproducible(solver);
+    };
+
     equation.convert(uf_solver, uf_solver);
     bool is_sat = uf_solver.solve();
     if (!is_sat) {
@@ -1029,13 +1322,18 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
         localRefine.mark_sum_for_refine(uf_solver, omega.get_call_tree_root(), equation);
         can_refine = !localRefine.get_refined_functions().empty();
     }
+    if (is_cex_reproducible(uf_solver)) {
+        status() << ("\n---Claim violated; counterexample of EUF reproduced concretely---\n") << eom;
+        report_failure();
+        return false;
+    }
 //---------------------------------------------------------------------------
     status() << "\n---EUF was not enough, lets change the encoding to LRA---\n" <<eom;
     initialize__lra_option_solver();
     auto lra_solver_ptr = std::unique_ptr<smtcheck_opensmt2t_lra>{new smtcheck_opensmt2t_lra(solver_options, "lra checker")};
     auto & lra_solver = *lra_solver_ptr;
     status() << "\n--Reading LRA and UF summary files: " << uf_summary_file_name << "," << lra_summary_file_name << eom;
-    reload_summaries(ns, summary_store, {uf_summary_file_name, lra_summary_file_name}, lra_solver, uf_solver );
+    reload_summaries(summary_store, {uf_summary_file_name, lra_summary_file_name}, lra_solver, uf_solver );
     omega.set_initial_precision(assertion, has_summary);
     reset_partition_info(equation, summary_store);
     equation.convert(lra_solver, lra_solver);
@@ -1067,6 +1365,11 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
         localRefine.mark_sum_for_refine(lra_solver, omega.get_call_tree_root(), equation);
         can_refine = !localRefine.get_refined_functions().empty();
     }
+    if (is_cex_reproducible(lra_solver)) {
+        status() << ("\n---Claim violated; counterexample of LRA reproduced concretely---\n") << eom;
+        report_failure();
+        return false;
+    }
     //cal prop --------------------------------------------------------------------------
     status() << "\n---EUF and LRA were not enough; trying to use prop logic ---\n" <<eom;
     std::string prop_summary_filename {"__summaries_prop"};
@@ -1074,9 +1377,9 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
     this->options.set_option("load-summaries", prop_summary_filename);
 
     init_solver_and_summary_store();
-    const auto & const_summary_store_prop = *(this->summary_store);
-    auto has_summary_prop = [&const_summary_store_prop](const std::string & function_name){
-        return const_summary_store_prop.function_has_summaries(function_name);
+    std::shared_ptr<const summary_storet> const_summary_store_prop = this->summary_store;
+    auto has_summary_prop = [const_summary_store_prop](const std::string & function_name){
+        return const_summary_store_prop->function_has_summaries(function_name);
     };
     omega.set_initial_precision(assertion, has_summary_prop);
     auto res = this->assertion_holds_smt(assertion, false);
@@ -1094,7 +1397,7 @@ bool core_checkert::check_sum_theoref_single(const assertion_infot &assertion)
 \*******************************************************************/
 void core_checkert::slice_target(partitioning_target_equationt & equation) {
     auto before = timestamp();
-    statistics() << "All SSA steps: " << equation.SSA_steps.size() << eom;
+    statistics() << "All SSA steps: " << equation.get_SSA_steps_count() << eom;
     partitioning_slice(equation);
     statistics() << "Ignored SSA steps after slice: " << equation.count_ignored_SSA_steps() << eom;
     auto after = timestamp();
@@ -1108,6 +1411,7 @@ void core_checkert::slice_target(partitioning_target_equationt & equation) {
 bool core_checkert::prepareSSA(symex_assertion_sumt & symex) {
     bool verified;
     verified = symex.prepare_SSA();
+    loop_bound_reached = loop_bound_reached || symex.is_loop_bound_reached();
 //    if(is_option_set("summary-validation")) {        // UpProver needs to negate the summary
 //        verified = symex.prepare_subtree_SSA();
 //    }
@@ -1126,6 +1430,7 @@ bool core_checkert::prepareSSA(symex_assertion_sumt & symex) {
 \*******************************************************************/
 bool core_checkert::refineSSA(symex_assertion_sumt & symex, const std::list<call_tree_nodet *> & functions_to_refine) {
     auto verified = symex.refine_SSA(functions_to_refine);
+    loop_bound_reached = loop_bound_reached || symex.is_loop_bound_reached();
 //    if(!verified && !options.get_bool_option(HiFrogOptions::NO_SLICING)){
 //        slice_target(symex.get_target_equation());
 //    }
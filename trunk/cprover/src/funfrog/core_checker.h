@@ -15,6 +15,8 @@
 #include "solvers/smtcheck_opensmt2_uf.h"
 #include "subst_scenario.h"
 #include <memory>
+#include <set>
+#include <vector>
 
 class prepare_formula_no_partitiont;
 class partitioning_target_equationt;
@@ -29,6 +31,7 @@ class smtcheck_opensmt2t_cuf;
 class smtcheck_opensmt2t_lia;
 class satcheck_opensmt2t;
 class ssa_solvert;
+class interval_invariantst;
 
 class core_checkert : public messaget
 {
@@ -40,6 +43,17 @@ public:
 
   void initialize_call_info();
   bool assertion_holds(const assertion_infot& assertion, bool store_summaries_with_assertion);
+  // Checks the given claims on one equation; returns the violated ones
+  std::set<goto_programt::const_targett> claims_hold_shared(const std::vector<goto_programt::const_targett> & claims);
+
+  // Has symex cut a loop by the unwind bound in any check so far?
+  bool is_loop_bound_reached() const { return loop_bound_reached; }
+
+  // Per-loop bounds and recursion depths of the automatic unwinding (--unwind-auto)
+  void set_unwind_bounds(unwind_boundst * bounds) {
+      unwind_bounds = bounds;
+      omega.set_unwind_bounds(bounds);
+  }
 
 #ifdef PRODUCE_PROOF
     //  bool check_sum_theoref_single(const assertion_infot& assertion);
@@ -67,6 +81,9 @@ protected:
   subst_scenariot omega;
   init_modet init;
   solver_optionst solver_options; // Init once, use when ever create a new solver
+  std::unique_ptr<interval_invariantst> invariants; // computed once, on the first use
+  bool loop_bound_reached {false};
+  unwind_boundst * unwind_bounds {nullptr}; // owned by the caller
   
   void initialize_solver();
   void initialize_summary_store();
@@ -94,6 +111,8 @@ protected:
   void report_failure();
   void assertion_violated(formula_managert& prop,
                           std::map<irep_idt, std::string> &guard_expln);
+  void assertion_violated_regenerated(const assertion_infot &assertion,
+                                      bool store_summaries_with_assertion);
   void assertion_violated_no_partition(prepare_formula_no_partitiont &prop,
                                        std::map<irep_idt, std::string> &guard_expln);
 
@@ -114,7 +133,17 @@ protected:
     bool prepareSSA(symex_assertion_sumt& symex);
     bool refineSSA(symex_assertion_sumt & symex, const std::list<call_tree_nodet *> & functions_to_refine);
 
+#ifdef PRODUCE_PROOF
+    // Summaries of outlined loops that are inductive replace the havoc at their recursive calls
+    void use_loop_invariants();
+    bool is_inductive_loop_summary(call_tree_nodet & loop_node, call_tree_nodet & recursive_call,
+                                   summary_idt summary_id);
+#endif
+
     bool is_option_set(std::string const & o) { return !options.get_option(o).empty();}
+
+    // Invariants of the program for symex, nullptr unless requested
+    const interval_invariantst * get_invariants();
     
     void delete_and_initialize_solver();
     
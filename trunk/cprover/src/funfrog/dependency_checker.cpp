@@ -41,13 +41,13 @@ void dependency_checkert::do_it(partitioning_target_equationt &equation){
   std::ofstream hl_list;
   hl_list.open ("__hl_list");
   std::size_t idx = 0; // index to ssa_steps
-    for(auto step : SSA_steps)
+    for(auto * step : SSA_steps)
     {
-      if (step.is_assert() && !omega.is_assertion_in_loop(step.source.pc)){
+      if (step->is_assert() && !omega.is_assertion_in_loop(step->source.pc)){
         asserts.push_back(idx);
         //cout << "ID: " << it->source.pc->location.get_claim() << " Condition: " << from_expr(ns, "", it->cond_expr) << '\n';
 //        instances[step->source.pc->source_location.get_property_id().c_str()]++;
-        hl_list << "Assertion: " << step.source.pc->source_location.get_property_id().c_str() << '\n';
+        hl_list << "Assertion: " << step->source.pc->source_location.get_property_id().c_str() << '\n';
       }
       ++idx;
     }
@@ -105,7 +105,7 @@ void dependency_checkert::do_it(hifrog_symex_target_equationt &equation){
       it++)
     {
       symex_target_equationt::SSA_stept& SSA_step=(*it);
-      this->SSA_steps.push_back(SSA_step);
+      this->SSA_steps.push_back(&SSA_step);
       SSA_map[SSA_step.ssa_full_lhs] = SSA_step.cond_expr;
     }
 
@@ -114,13 +114,13 @@ void dependency_checkert::do_it(hifrog_symex_target_equationt &equation){
     std::ofstream hl_list;
     hl_list.open ("__hl_list");
     std::size_t idx = 0;
-    for(auto step : SSA_steps)
+    for(auto * step : SSA_steps)
     {
-      if (step.is_assert() && !omega.is_assertion_in_loop(step.source.pc)){
+      if (step->is_assert() && !omega.is_assertion_in_loop(step->source.pc)){
         asserts.push_back(idx);
         //cout << "ID: " << it->source.pc->location.get_claim() << " Condition: " << from_expr(ns, "", it->cond_expr) << '\n';
 //        instances[step->source.pc->source_location.get_property_id().c_str()]++;
-        hl_list << "Assertion: " << step.source.pc->source_location.get_property_id().c_str() << '\n';
+        hl_list << "Assertion: " << step->source.pc->source_location.get_property_id().c_str() << '\n';
       }
       ++idx;
     }
@@ -175,7 +175,7 @@ void dependency_checkert::find_var_deps(UnionFind<std::string> &deps_ds, std::ma
     auto end = SSA_steps.begin() + asserts.back();
     for( ; it != end; ++it)
     {
-        auto ass = *it;
+        const auto & ass = **it;
       if (ass.is_assignment() || ass.is_assume() || ass.is_assert())
       {
             symbol_sett all_symbols;
@@ -263,7 +263,7 @@ void dependency_checkert::find_assert_deps()
     for (unsigned i = 0; i < asserts.size(); i++)
     {
       auto assert1_idx = asserts[i];
-      auto & assert_1 = SSA_steps[assert1_idx];
+      const auto & assert_1 = *SSA_steps[assert1_idx];
       symbol_sett first_symbols;
       get_expr_symbols(assert_1.guard, first_symbols);
       get_expr_symbols(assert_1.cond_expr, first_symbols);
@@ -272,7 +272,7 @@ void dependency_checkert::find_assert_deps()
       {
         indeps++;
         auto assert2_idx = asserts[j];
-        auto & assert_2 = SSA_steps[assert2_idx];
+        const auto & assert_2 = *SSA_steps[assert2_idx];
         if (!compare_assertions(assert1_idx, assert2_idx))
           continue;
 
@@ -334,32 +334,32 @@ void dependency_checkert::print_SSA_steps_infos()
   std::cout << '\n' << "Printing SSA data" << '\n' << '\n';
     for(SSA_stepst::iterator it = SSA_steps.begin(); it!=SSA_steps.end(); ++it)
     {
-      it->output(ns, std::cout);
+      (*it)->output(ns, std::cout);
       std::cout << "Andrea's data:\n";
-      std::cout << "Guard = " << from_expr(ns, "", it->guard) << '\n';
-      if (it->is_assignment())
+      std::cout << "Guard = " << from_expr(ns, "", (*it)->guard) << '\n';
+      if ((*it)->is_assignment())
       {
             std::cout << "  Type = ASSIGNMENT" << '\n';
             std::cout << "  Assignment type = ";
-            if (it->assignment_type == symex_targett::HIDDEN) std::cout << "HIDDEN" << '\n';
-            else if (it->assignment_type == symex_targett::STATE) std::cout << "STATE" << '\n';
+            if ((*it)->assignment_type == symex_targett::HIDDEN) std::cout << "HIDDEN" << '\n';
+            else if ((*it)->assignment_type == symex_targett::STATE) std::cout << "STATE" << '\n';
             else std::cout << "NOT EXPECTED" << '\n';
-            std::cout << "  Condition expression = " << from_expr(ns, "", it->cond_expr) << '\n';
+            std::cout << "  Condition expression = " << from_expr(ns, "", (*it)->cond_expr) << '\n';
             std::cout << "Symbols in the expression: ";
-            print_expr_symbols(std::cout, it->cond_expr);
+            print_expr_symbols(std::cout, (*it)->cond_expr);
             std::cout << '\n';
-            std::cout << "left-hand side: " << from_expr(ns, "", it->ssa_lhs) << '\n';
+            std::cout << "left-hand side: " << from_expr(ns, "", (*it)->ssa_lhs) << '\n';
             std::cout << "Symbols in the left-hand side: ";
-            print_expr_symbols(std::cout, it->ssa_lhs);
+            print_expr_symbols(std::cout, (*it)->ssa_lhs);
             std::cout << '\n';
-            std::cout << "right-hand side: " << from_expr(ns, "", it->ssa_rhs) << '\n';
+            std::cout << "right-hand side: " << from_expr(ns, "", (*it)->ssa_rhs) << '\n';
             std::cout << "Symbols in the right-hand side: ";
-            print_expr_symbols(std::cout, it->ssa_rhs);
+            print_expr_symbols(std::cout, (*it)->ssa_rhs);
             std::cout << '\n';
             symbol_sett lhs_symbols, rhs_symbols, guard_symbols;
-            get_expr_symbols(it->ssa_lhs, lhs_symbols);
-            get_expr_symbols(it->ssa_rhs, rhs_symbols);
-            get_expr_symbols(it->guard, guard_symbols);
+            get_expr_symbols((*it)->ssa_lhs, lhs_symbols);
+            get_expr_symbols((*it)->ssa_rhs, rhs_symbols);
+            get_expr_symbols((*it)->guard, guard_symbols);
             dstring temp;
             for (symbol_sett::iterator lhs_it = lhs_symbols.begin(); lhs_it != lhs_symbols.end(); ++lhs_it)
             {
@@ -378,22 +378,22 @@ void dependency_checkert::print_SSA_steps_infos()
                 }
             }
         }
-      else if (it->is_assert())
+      else if ((*it)->is_assert())
       {
         std::cout << "  Type = ASSERT" << '\n';
-        std::cout << "  Condition expression = " << from_expr(ns, "", it->cond_expr) << '\n';
-        std::cout << "  Comment = " << it->comment << '\n';
+        std::cout << "  Condition expression = " << from_expr(ns, "", (*it)->cond_expr) << '\n';
+        std::cout << "  Comment = " << (*it)->comment << '\n';
       }
-      else if (it->is_assume())
+      else if ((*it)->is_assume())
       {
         std::cout << "  Type = ASSUME" << '\n';
-        std::cout << "  Condition expression = " << from_expr(ns, "", it->cond_expr) << '\n';
+        std::cout << "  Condition expression = " << from_expr(ns, "", (*it)->cond_expr) << '\n';
       }
-      else if (it->is_location())
+      else if ((*it)->is_location())
       {
         std::cout << "  Type = LOCATION" << '\n';
       }
-      else if (it->is_output())
+      else if ((*it)->is_output())
       {
         std::cout << "  Type = OUTPUT" << '\n';
       }
@@ -401,20 +401,20 @@ void dependency_checkert::print_SSA_steps_infos()
       {
         std::cout << "  Type = NOT EXPECTED" << '\n';
       }
-        if(it->source.is_set)
+        if((*it)->source.is_set)
         {
-          std::cout << "  Thread = " << it->source.thread_nr << '\n';
-          if(it->source.pc->location.is_not_nil())
-            std::cout << "  Location = " << it->source.pc->location << '\n';
+          std::cout << "  Thread = " << (*it)->source.thread_nr << '\n';
+          if((*it)->source.pc->location.is_not_nil())
+            std::cout << "  Location = " << (*it)->source.pc->location << '\n';
           else
             std::cout << '\n';
         }
-        if (it->cond_expr.has_operands())
+        if ((*it)->cond_expr.has_operands())
         {
             std::cout << "  Operands:" << '\n';
 
             int k = 0;
-            Forall_operands(op, it->cond_expr)
+            Forall_operands(op, (*it)->cond_expr)
             {
             std::cout << "    Op[" << k << "] = ";
             //expr_pretty_print(tempstr, *op, 2);
@@ -543,7 +543,7 @@ void dependency_checkert::print_SSA_steps()
 //    for(symex_target_equationt::SSA_stepst::iterator it = SSA_steps.begin(); it!=SSA_steps.end(); ++it)
 //    {
     for (const auto & ssa_stp : SSA_steps) {
-      ssa_stp.output(std::cout);
+      ssa_stp->output(std::cout);
     }
 }
 #endif
@@ -560,7 +560,7 @@ void dependency_checkert::reconstruct_exec_SSA_order(partitioning_target_equatio
   for(auto ssa_step : SSA_steps)
   {
     symex_target_equationt::SSA_stept& SSA_step = *ssa_step;
-    this->SSA_steps.push_back(SSA_step);
+    this->SSA_steps.push_back(ssa_step);
     SSA_map[SSA_step.ssa_full_lhs] = SSA_step.cond_expr;
   }
 }
@@ -590,13 +590,13 @@ long dependency_checkert::find_implications() {
     for (unsigned i = 0; i < asserts.size(); i++)
     {
         auto assert1_idx = asserts[i];
-        auto assert_1 = SSA_steps[assert1_idx];
+        const auto & assert_1 = *SSA_steps[assert1_idx];
         for (unsigned j = i+1; j < asserts.size(); j++)
         {
             checks++;
             std::pair<bool, timet> checkres;
             auto assert2_idx = asserts[j];
-            auto assert_2 = SSA_steps[assert2_idx];
+            const auto & assert_2 = *SSA_steps[assert2_idx];
             if (compare_assertions(assert1_idx, assert2_idx)
                 && assert_deps[assert1_idx][assert2_idx] == DEPT
                     )
@@ -673,9 +673,10 @@ long dependency_checkert::find_implications() {
     {
         if (weaker[i] == true)
         {
-            auto removable = SSA_steps[asserts[i]];
+            // only reported: the steps are shared with the equation, which keeps the
+            // assertion (the checker used to work on copies of the steps)
+            const auto & removable = *SSA_steps[asserts[i]];
             status () << "Removing << " << removable.source.pc->source_location.get_line() << eom;
-            removable.ignore = true;
         }
     }
     try{
@@ -685,7 +686,7 @@ long dependency_checkert::find_implications() {
         hl_weaker.open ("__hl_weaker");
         //int hldiscardable = 0;
         for (int i = asserts.size() - 1; i >= 0; i--){
-            auto ass = SSA_steps[asserts[i]];
+            const auto & ass = *SSA_steps[asserts[i]];
             if (weaker[i] == true)
                 hl_weaker << ass.source.pc->source_location.get_property_id().c_str() << std::endl;
             if (stronger[i] == true)
@@ -708,11 +709,11 @@ void dependency_checkert::convert_assumptions(
     SSA_steps_it it=it1;
     while(it!=it2)
     {
-        if(((*it).is_assume() || ((*it).is_assert() && it != it2)) && !(*it).ignore)
+        if(((*it)->is_assume() || ((*it)->is_assert() && it != it2)) && !(*it)->ignore)
         {
             //std::cout << "convert assume :" << from_expr(ns, "", (*it)->cond_expr) <<"\n";
-            convertor.set_to_true((*it).cond_expr);
-            set_guards_to_true(convertor, ((*it).cond_expr));
+            convertor.set_to_true((*it)->cond_expr);
+            set_guards_to_true(convertor, ((*it)->cond_expr));
         }
         it++;
     }
@@ -727,10 +728,10 @@ void dependency_checkert::convert_assumptions(
 void dependency_checkert::convert_assertions(
         convertort &convertor, SSA_steps_it &it2)
 {
-    assert((*it2).is_assert());
+    assert((*it2)->is_assert());
     //std::cout << "convert assert :" << from_expr(ns, "", (*it2)->cond_expr) <<"\n";
-    set_guards_to_true(convertor, ((*it2).cond_expr));
-    convertor.set_to_false((*it2).cond_expr);
+    set_guards_to_true(convertor, ((*it2)->cond_expr));
+    convertor.set_to_false((*it2)->cond_expr);
 }
 
 void dependency_checkert::convert_io(
@@ -743,21 +744,19 @@ void dependency_checkert::convert_io(
 
     while (it!=it3){
         for(std::list<exprt>::const_iterator
-                    o_it=(*it).io_args.begin();
-            o_it!=(*it).io_args.end();
+                    o_it=(*it)->io_args.begin();
+            o_it!=(*it)->io_args.end();
             o_it++)
         {
             exprt tmp=*o_it;
-            if(tmp.is_constant() ||
-               tmp.id()==ID_string_constant)
-                (*it).converted_io_args.push_back(tmp);
-            else
+            // the steps belong to the equation, the converted arguments are not stored there
+            if(!tmp.is_constant() &&
+               tmp.id()!=ID_string_constant)
             {
                 symbol_exprt symbol;
                 symbol.type()=tmp.type();
                 symbol.set_identifier(CProverStringConstants::IO_CONST + std::to_string(io_count++));
                 convertor.set_to_true(equal_exprt(tmp, symbol));
-                (*it).converted_io_args.push_back(symbol);
             }
         }
         it++;
@@ -795,8 +794,15 @@ void dependency_checkert::set_guards_to_true(convertort &convertor, const exprt
 void dependency_checkert::convert_delta_SSA(convertort &convertor,
                                             SSA_steps_it &it1, SSA_steps_it &it2)
 {
-    convert_guards(convertor, it1, it2);
-    convert_assignments(convertor, it1, it2);
+    // not hifrog::convert_guards: the literals of the guards belong to the equation
+    for (SSA_steps_it it = it1; it != it2; ++it) {
+        if (!(*it)->ignore) {
+            convert_expr(convertor, (*it)->guard);
+            if ((*it)->is_assignment()) {
+                convertor.set_to_true((*it)->cond_expr);
+            }
+        }
+    }
     convert_assumptions(convertor, it1, it2);
     convert_assertions(convertor, it2);
     convert_io(convertor, it1, it2);
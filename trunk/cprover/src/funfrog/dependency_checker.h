@@ -54,7 +54,8 @@ public:
   void do_it(partitioning_target_equationt &equation);
   void do_it(hifrog_symex_target_equationt &equation);
 
-  using SSA_stepst = std::vector<symex_target_equationt::SSA_stept> ;
+  // the steps of the equation, in the order of execution (not copied)
+  using SSA_stepst = std::vector<symex_target_equationt::SSA_stept*> ;
   using SSA_steps_it = SSA_stepst::iterator;
 
   void find_var_deps(UnionFind<std::string> &deps_ds, std::map<std::string, bool> &visited);
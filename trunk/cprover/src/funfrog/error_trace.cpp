@@ -8,6 +8,7 @@
 
 #include "error_trace.h"
 
+#include "cex_replayer.h"
 #include "solvers/smtcheck_opensmt2_cuf.h"
 #include <funfrog/utils/naming_helpers.h>
 #include <langapi/language_util.h>
@@ -41,6 +42,9 @@ void error_tracet::build_goto_trace(
     if(!solver->is_assignment_true(literal_to_flaref(SSA_step.guard_literal)))
       continue;
 
+    if(SSA_step.is_assert() && claim && SSA_step.source.pc != *claim)
+      continue;
+
     if(SSA_step.is_assignment() &&
        SSA_step.assignment_type==symex_target_equationt::assignment_typet::HIDDEN)
       continue;
@@ -132,6 +136,27 @@ void error_tracet::build_goto_trace(
   }
 }
 
+/*******************************************************************\
+Function: error_tracet::replay_concretely
+ Inputs: the program the trace was built for
+ Outputs: true if the violated assertion fails in a concrete run
+ Purpose: To tell real counterexamples from the spurious ones when the
+ encoding over-approximates: the trace may only look spurious because it
+ writes an unsupported variable that does not matter for the violation
+\*******************************************************************/
+bool error_tracet::replay_concretely(
+        const symbol_tablet &symbol_table,
+        const goto_functionst &goto_functions,
+        message_handlert &message_handler)
+{
+    cex_replayert replayer(symbol_table, goto_functions, message_handler);
+    if (!replayer.replay(goto_trace, replay_step_limit))
+        return false;
+
+    isOverAppox = error_tracet::isOverAppoxt::REAL;
+    return true;
+}
+
 /*******************************************************************\
 
 Function: error_trace::show_trace_vars_value
@@ -28,6 +28,10 @@ public:
 	void build_goto_trace(
 			const SSA_steps_orderingt &SSA_steps,
 			ssa_solvert &decider);
+
+	// The trace leads to a violation of this claim, the assertions of the
+	// other claims are left out (several claims checked on one formula)
+	void set_claim(goto_programt::const_targett _claim) { claim = _claim; }
         
 	void show_goto_trace(
     std::ostream &out,
@@ -36,6 +40,13 @@ public:
 
     error_tracet::isOverAppoxt is_trace_overapprox(ssa_solvert &decider, const SSA_steps_orderingt &SSA_steps);
 
+    // Replays the built trace on the concrete interpreter (see cex_replayert);
+    // if the violation is reproduced, the trace is REAL
+    bool replay_concretely(
+            const symbol_tablet &symbol_table,
+            const goto_functionst &goto_functions,
+            message_handlert &message_handler);
+
 	void build_goto_trace_formula(
             std::vector<exprt> &exprs,
             std::map<const exprt, int> &model,
@@ -43,8 +54,12 @@ public:
 
 
 private:
+	// Limit on the number of instructions executed by replay_concretely
+	static const std::size_t replay_step_limit = 1000000;
+
 	isOverAppoxt isOverAppox;
 	goto_tracet goto_trace; // The error trace
+	optionalt<goto_programt::const_targett> claim;
 
 	void show_state_header(
 			  std::ostream &out,
@@ -25,6 +25,33 @@ void formula_managert::convert_to_formula(convertort &convertor, interpolating_s
     message.status() << "CONVERSION TIME: " << time_gap(after,before) << message.eom;
 }
 
+/*******************************************************************
+ Purpose: Starts converting the partitions of the SSA form as symex
+ finishes them
+
+\*******************************************************************/
+void formula_managert::start_streaming_conversion(convertort &convertor, interpolating_solvert &interpolator)
+{
+    equation.start_streaming_conversion(convertor, interpolator);
+}
+
+/*******************************************************************
+ Purpose: Completes the conversion started by start_streaming_conversion;
+ the reported time is only the part not overlapped with symex
+
+\*******************************************************************/
+void formula_managert::finish_streaming_conversion(convertort &convertor, interpolating_solvert &interpolator)
+{
+    auto before=timestamp();
+    auto streamed = equation.finish_streaming_conversion(convertor, interpolator);
+
+    auto after=timestamp();
+
+    message.statistics() << "Partitions converted during symex: " << streamed << " of "
+                         << equation.get_partitions().size() << message.eom;
+    message.status() << "CONVERSION TIME: " << time_gap(after,before) << message.eom;
+}
+
 /*******************************************************************
  Purpose: Checks if prepared formula is SAT
 
@@ -55,26 +82,63 @@ bool formula_managert::is_satisfiable(solvert& decider)
  Purpose:
 
 \*******************************************************************/
-void formula_managert::error_trace(ssa_solvert &decider, const namespacet &ns,
+bool formula_managert::error_trace(ssa_solvert &decider, const namespacet &ns,
                                    std::map<irep_idt, std::string> &guard_expln)
 {      
     // Only if can build an error trace - give notice to the user
     message.status() << ("Building error trace") << message.eom;
     
     error_tracet error_trace;
+    if (error_trace_claim) {
+        error_trace.set_claim(*error_trace_claim);
+    }
+    bool reproduced = false;
     
     error_tracet::isOverAppoxt isOverAppox = error_trace.is_trace_overapprox(decider, equation.get_steps_exec_order());
+    if (isOverAppox == error_tracet::isOverAppoxt::SPURIOUS && replay_functions)
+    {
+        error_trace.build_goto_trace(equation.get_steps_exec_order(), decider);
+        reproduced = error_trace.replay_concretely(*replay_symbol_table, *replay_functions,
+                                                   message.get_message_handler());
+        if (reproduced) {
+            message.status() << "The counterexample is reproduced by a concrete replay" << message.eom;
+            isOverAppox = error_tracet::isOverAppoxt::REAL;
+        }
+    }
     if (isOverAppox == error_tracet::isOverAppoxt::SPURIOUS)
     {
         // Same as in funfrog/error_tracet::show_goto_trace
         message.warning () << "\nWARNING: Use over approximation. Cannot create an error trace. \n";
         message.warning () << "         Use --logic with Different Logic to Try Creating an Error Trace." << message.eom;
-        return; // Cannot really print a trace
+        return false; // Cannot really print a trace
     }
 
-    error_trace.build_goto_trace(equation.get_steps_exec_order(), decider);
+    if (!reproduced) {
+        error_trace.build_goto_trace(equation.get_steps_exec_order(), decider);
+    }
 
     message.result () << "\nCounterexample:\n";
     error_trace.show_goto_trace(message.result(), ns, guard_expln);
     message.result () << message.eom;
+    return reproduced;
+}
+
+/*******************************************************************
+ Purpose: Tells if the model of a SAT formula is a real counterexample,
+ i.e., if replaying it concretely violates the assertion
+
+\*******************************************************************/
+bool formula_managert::is_cex_reproducible(ssa_solvert &decider)
+{
+    assert(replay_functions && replay_symbol_table);
+    auto before=timestamp();
+    error_tracet error_trace;
+    error_trace.build_goto_trace(equation.get_steps_exec_order(), decider);
+    bool reproduced = error_trace.replay_concretely(*replay_symbol_table, *replay_functions,
+                                                    message.get_message_handler());
+    auto after=timestamp();
+    message.status() << "REPLAY TIME: " << time_gap(after,before) << message.eom;
+    message.status() << "Counterexample " << (reproduced ? "reproduced" : "not reproduced")
+                     << " by a concrete replay" << message.eom;
+    return reproduced;
 }
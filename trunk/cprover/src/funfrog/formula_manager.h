@@ -4,6 +4,8 @@
 
 #include <util/message.h>
 #include <util/ui_message.h>
+#include <util/optional.h>
+#include <goto-programs/goto_program.h>
 
 class assertion_infot;
 class namespacet;
@@ -12,6 +14,8 @@ class interpolating_solvert;
 class solvert;
 class convertort;
 class ssa_solvert;
+class goto_functionst;
+class symbol_tablet;
 
 class formula_managert
 {
@@ -25,7 +29,27 @@ public:
     
     void convert_to_formula(convertort &convertor, interpolating_solvert &interpolator);
 
-    void error_trace(ssa_solvert &decider, const namespacet &ns, std::map<irep_idt, std::string> &guard_expln);
+    // Conversion overlapped with symex: start before generating the SSA,
+    // finish instead of the first convert_to_formula
+    void start_streaming_conversion(convertort &convertor, interpolating_solvert &interpolator);
+    void finish_streaming_conversion(convertort &convertor, interpolating_solvert &interpolator);
+
+    // Returns true if the counterexample was reproduced by the concrete replay
+    bool error_trace(ssa_solvert &decider, const namespacet &ns, std::map<irep_idt, std::string> &guard_expln);
+
+    // The next error traces lead to a violation of this claim (see error_tracet::set_claim)
+    void set_error_trace_claim(goto_programt::const_targett claim) { error_trace_claim = claim; }
+
+    // Counterexamples that look spurious due to the over-approximating
+    // encoding are replayed concretely on this program
+    void set_replay_program(const goto_functionst &functions, const symbol_tablet &symbol_table) {
+        replay_functions = &functions;
+        replay_symbol_table = &symbol_table;
+    }
+
+    // Builds the error trace from the model of the decider and replays it
+    // concretely (needs set_replay_program); true if the violation is reproduced
+    bool is_cex_reproducible(ssa_solvert &decider);
 
     bool is_satisfiable(solvert & decider);
 private:
@@ -34,6 +58,11 @@ private:
     messaget message;
     partitioning_target_equationt &equation;
 
+    optionalt<goto_programt::const_targett> error_trace_claim;
+
+    const goto_functionst * replay_functions {nullptr};
+    const symbol_tablet * replay_symbol_table {nullptr};
+
 };
 #endif
 
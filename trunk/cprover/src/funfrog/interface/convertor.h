@@ -5,6 +5,7 @@
 #include <util/expr.h>
 #include "FlaRef.h"
 
+#include <unordered_set>
 #include <vector>
 
 /*
@@ -41,5 +42,16 @@ public:
 
     virtual FlaRef get_and_clear_var_constraints() { return const_formula(true); }
 
+    // Can the constraints of the data types be restricted to some symbols? Only if
+    // they are assumptions; asserted constraints are a part of the error condition
+    virtual bool can_restrict_type_constraints() const { return false; }
+
+    // Restricts the type constraints to the given symbols
+    virtual void set_bounded_symbols(std::unordered_set<irep_idt> symbols) {}
+
+    // Forgets the conversions of the expressions whose nodes are not in the set
+    // (e.g., of the released SSA steps), so that the nodes can be freed
+    virtual void retain_expressions(const std::unordered_set<const irept::dt *> & used) {}
+
 };
 #endif //PROJECT_CONVERTOR_H
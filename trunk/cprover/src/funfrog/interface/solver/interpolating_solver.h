@@ -11,6 +11,7 @@ interpolation.
 #include <funfrog/solvers/itp_fwd.h>
 #include <funfrog/solvers/interpolating_solver_fwd.h>
 
+class exprt;
 class symbol_exprt;
 
 class interpolating_solvert
@@ -45,6 +46,15 @@ public:
   virtual void close_partition() = 0;
 
   virtual void insert_substituted(const itpt & itp, const std::vector<symbol_exprt> & symbols) = 0;
+
+  // Same as insert_substituted, but the symbols with a known (non-nil) value
+  // are replaced by the value and the summary is simplified accordingly.
+  // Solvers not supporting the specialization insert the summary unchanged.
+  virtual void insert_specialized(const itpt & itp, const std::vector<symbol_exprt> & symbols,
+                                  const std::vector<exprt> & values) {
+    (void)values;
+    insert_substituted(itp, symbols);
+  }
   virtual void substitute_negate_insert(const itpt & itp, const std::vector<symbol_exprt> & symbols) = 0;
 };
 
@@ -0,0 +1,238 @@
+/*******************************************************************
+
+ Module: Interval invariants of the goto program, computed by abstract
+ interpretation before symex and used to constrain the partitions
+
+\*******************************************************************/
+
+#include "interval_invariants.h"
+#include "partition_iface.h"
+
+#include <analyses/dirty.h>
+#include <util/expr_iterator.h>
+#include <util/expr_util.h>
+#include <util/replace_symbol.h>
+#include <util/ssa_expr.h>
+
+namespace {
+// Can the instruction change a variable through a pointer?
+bool writes_through_pointer(const goto_programt::instructiont & instruction)
+{
+  if (instruction.is_assign()) {
+    return has_subexpr(to_code_assign(instruction.code).lhs(), ID_dereference);
+  }
+  if (instruction.is_function_call()) {
+    return has_subexpr(to_code_function_call(instruction.code).lhs(), ID_dereference);
+  }
+  // e.g., array_set and array_copy
+  return instruction.is_other();
+}
+
+// Does the cast keep every value of its operand?
+bool is_value_preserving(const typecast_exprt & cast)
+{
+  const typet & from = cast.op().type();
+  const typet & to = cast.type();
+  if (!interval_domaint::is_int(from) || !interval_domaint::is_int(to)) {
+    return from == to;
+  }
+  const std::size_t from_width = to_bitvector_type(from).get_width();
+  const std::size_t to_width = to_bitvector_type(to).get_width();
+  if (from.id() == to.id()) {
+    return from_width <= to_width;
+  }
+  // unsigned to signed needs a wider type, signed to unsigned loses the negative values
+  return from.id() == ID_unsignedbv && from_width < to_width;
+}
+
+// Would the interval domain get the expression wrong? It strips the casts,
+// and the intervals of floats are dropped anyway
+bool is_inexact(const exprt & expr)
+{
+  for (auto it = expr.depth_cbegin(); it != expr.depth_cend(); ++it) {
+    if (interval_domaint::is_float(it->type())) { return true; }
+    if (it->id() == ID_typecast && !is_value_preserving(to_typecast_expr(*it))) { return true; }
+  }
+  return false;
+}
+}
+
+/*******************************************************************
+ Function: interval_invariants_domaint::transform
+
+ Purpose: The transformer of the interval domain, fixed for calls that
+ are not followed by remove_returns, for writes through pointers and
+ for the casts and floats the domain gets wrong
+\*******************************************************************/
+void interval_invariants_domaint::transform(
+  const irep_idt &function_from,
+  locationt from,
+  const irep_idt &function_to,
+  locationt to,
+  ai_baset &ai,
+  const namespacet &ns)
+{
+  if (from->is_end_function()) {
+    // Return edge: the return site follows the call, which assigns its lhs
+    const auto call = std::prev(to);
+    if (call->is_function_call()) {
+      intervals.havoc_rec(to_code_function_call(call->code).lhs());
+    }
+    return;
+  }
+
+  if (from->is_goto() || from->is_assume()) {
+    // a condition the domain gets wrong is not assumed at all
+    if (!is_inexact(from->guard)) {
+      intervals.transform(function_from, from, function_to, to, ai, ns);
+    }
+  }
+  else {
+    intervals.transform(function_from, from, function_to, to, ai, ns);
+  }
+
+  if (from->is_assign()) {
+    const code_assignt & assign = to_code_assign(from->code);
+    if (is_inexact(assign.lhs()) || is_inexact(assign.rhs())) {
+      intervals.havoc_rec(assign.lhs());
+    }
+  }
+  intervals.forget_floats();
+
+  if (writes_through_pointer(*from)) {
+    for (const auto & symbol : static_cast<const interval_invariantst &>(ai).get_address_taken_symbols()) {
+      intervals.havoc_rec(symbol);
+    }
+  }
+}
+
+interval_invariantst::interval_invariantst(const goto_functionst & _goto_functions, const namespacet & ns) :
+  goto_functions(_goto_functions)
+{
+  for (const auto & identifier : dirtyt(goto_functions).get_dirty_ids()) {
+    const symbolt * symbol = nullptr;
+    if (!ns.lookup(identifier, symbol)) {
+      address_taken.push_back(symbol->symbol_expr());
+    }
+  }
+  (*this)(goto_functions, ns);
+}
+
+/*******************************************************************
+ Function: interval_invariantst::is_reachable
+
+ Purpose: A location the analysis never reaches cannot be reached by
+ any execution (locations of unknown programs are reachable)
+\*******************************************************************/
+bool interval_invariantst::is_reachable(locationt location) const
+{
+  const auto it = state_map.find(location);
+  return it == state_map.end() || !it->second.is_bottom();
+}
+
+/*******************************************************************
+ Function: interval_invariantst::interval_of
+
+ Purpose: The interval of the source (a variable of the program) in the
+ given state, as a constraint over the target (its SSA symbol)
+\*******************************************************************/
+exprt interval_invariantst::interval_of(
+  const interval_invariants_domaint & state,
+  const exprt & source,
+  const symbol_exprt & target) const
+{
+  if (source.id() != ID_symbol || source.type() != target.type() ||
+      !interval_domaint::is_int(target.type())) {
+    return true_exprt();
+  }
+  exprt result = state.make_expression(to_symbol_expr(source));
+  if (!result.is_true()) {
+    replace_symbolt replace;
+    replace.insert(to_symbol_expr(source), target);
+    replace(result);
+  }
+  return result;
+}
+
+/*******************************************************************
+ Function: interval_invariantst::entry_invariant
+
+ Purpose: Constraints on the interface symbols of the arguments and
+ accessed globals (in this order) implied by the state at the call site
+\*******************************************************************/
+exprt interval_invariantst::entry_invariant(
+  locationt call_site,
+  const partition_ifacet & partition_iface) const
+{
+  const auto it = state_map.find(call_site);
+  if (it == state_map.end() || it->second.is_bottom()) {
+    return true_exprt();
+  }
+  const interval_invariants_domaint & state = it->second;
+  const code_function_callt & call = to_code_function_call(call_site->code);
+  const auto parameters = goto_functions.function_map.at(partition_iface.function_id).type.parameters().size();
+
+  exprt::operandst conjuncts;
+  for (std::size_t i = 0; i < partition_iface.argument_symbols.size(); ++i) {
+    const symbol_exprt & symbol = partition_iface.argument_symbols[i];
+    exprt source = i < parameters
+                   ? (i < call.arguments().size() ? call.arguments()[i] : nil_exprt())
+                   : symbol_exprt(to_ssa_expr(symbol).get_object_name(), symbol.type());
+    exprt invariant = interval_of(state, source, symbol);
+    if (!invariant.is_true()) {
+      conjuncts.push_back(invariant);
+    }
+  }
+  return conjunction(conjuncts);
+}
+
+/*******************************************************************
+ Function: interval_invariantst::exit_invariant
+
+ Purpose: Constraints on the interface symbols of the modified globals and
+ of the return value implied by the states where the function returns
+\*******************************************************************/
+exprt interval_invariantst::exit_invariant(const partition_ifacet & partition_iface) const
+{
+  const goto_programt & body = goto_functions.function_map.at(partition_iface.function_id).body;
+  if (body.instructions.empty()) {
+    return true_exprt();
+  }
+  const auto end_it = state_map.find(std::prev(body.instructions.end()));
+  // a function that never returns is left alone, errors in its subtree still count
+  if (end_it == state_map.end() || end_it->second.is_bottom()) {
+    return true_exprt();
+  }
+
+  exprt::operandst conjuncts;
+  for (const symbol_exprt & global : partition_iface.out_arg_symbols) {
+    exprt invariant = interval_of(end_it->second,
+                                  symbol_exprt(to_ssa_expr(global).get_object_name(), global.type()), global);
+    if (!invariant.is_true()) {
+      conjuncts.push_back(invariant);
+    }
+  }
+
+  if (partition_iface.returns_value) {
+    // one disjunct per reachable return
+    const symbol_exprt & retval = partition_iface.retval_symbol;
+    exprt::operandst disjuncts;
+    bool known = true;
+    forall_goto_program_instructions(it, body) {
+      if (!it->is_return() || !is_reachable(it)) { continue; }
+      const exprt & value = to_code_return(it->code).return_value();
+      exprt invariant = value.is_constant() && value.type() == retval.type()
+                        ? equal_exprt(retval, value)
+                        : interval_of(state_map.at(it), value, retval);
+      if (invariant.is_true()) {
+        known = false;
+        break;
+      }
+      disjuncts.push_back(invariant);
+    }
+    if (known && !disjuncts.empty()) {
+      conjuncts.push_back(disjunction(disjuncts));
+    }
+  }
+  return conjunction(conjuncts);
+}
@@ -0,0 +1,92 @@
+/*******************************************************************
+
+ Module: Interval invariants of the goto program, computed by abstract
+ interpretation before symex and used to constrain the partitions
+
+ The interval domain of CPROVER expects the returns to be removed and
+ ignores writes through pointers; we keep the returns (see parser.cpp),
+ so the lhs of a call is havocked on the return edge, and every write
+ through a pointer havocs the variables whose address is taken.
+
+ It also strips the casts, so a variable assigned a narrowing cast
+ would get the interval of the operand; such variables are havocked and
+ such conditions ignored. The intervals of floats are not kept at all
+ (they are not exact, and their join is broken).
+
+\*******************************************************************/
+
+#ifndef HIFROG_INTERVAL_INVARIANTS_H
+#define HIFROG_INTERVAL_INVARIANTS_H
+
+#include <analyses/ai.h>
+#include <analyses/interval_domain.h>
+
+class partition_ifacet;
+
+class interval_invariants_domaint : public ai_domain_baset
+{
+public:
+  void transform(
+    const irep_idt &function_from,
+    locationt from,
+    const irep_idt &function_to,
+    locationt to,
+    ai_baset &ai,
+    const namespacet &ns) override;
+
+  void output(std::ostream &out, const ai_baset &ai, const namespacet &ns) const override {
+    intervals.output(out, ai, ns);
+  }
+
+  bool merge(const interval_invariants_domaint &b, locationt from, locationt to) {
+    return intervals.merge(b.intervals, from, to);
+  }
+
+  void make_bottom() override { intervals.make_bottom(); }
+  void make_top() override { intervals.make_top(); }
+  void make_entry() override { intervals.make_entry(); }
+  bool is_bottom() const override { return intervals.is_bottom(); }
+  bool is_top() const override { return intervals.is_top(); }
+
+  exprt make_expression(const symbol_exprt &symbol) const { return intervals.make_expression(symbol); }
+
+private:
+  class intervalst : public interval_domaint {
+  public:
+    using interval_domaint::havoc_rec;
+    void forget_floats() { float_map.clear(); }
+  };
+  intervalst intervals;
+};
+
+class interval_invariantst : public ait<interval_invariants_domaint>
+{
+public:
+  interval_invariantst(const goto_functionst & goto_functions, const namespacet & ns);
+
+  // False if the location is proven unreachable
+  bool is_reachable(locationt location) const;
+
+  // Intervals of the arguments and accessed globals at the call site,
+  // over the symbols of the interface (true if nothing is known)
+  exprt entry_invariant(locationt call_site, const partition_ifacet & partition_iface) const;
+
+  // Intervals of the modified globals and of the return value at the end of
+  // the function (any calling context), over the symbols of the interface
+  exprt exit_invariant(const partition_ifacet & partition_iface) const;
+
+  const std::vector<symbol_exprt> & get_address_taken_symbols() const {
+    return address_taken;
+  }
+
+private:
+  const goto_functionst & goto_functions;
+
+  // variables that can be changed through a pointer
+  std::vector<symbol_exprt> address_taken;
+
+  exprt interval_of(const interval_invariants_domaint & state, const exprt & source,
+                    const symbol_exprt & target) const;
+};
+
+#endif //HIFROG_INTERVAL_INVARIANTS_H
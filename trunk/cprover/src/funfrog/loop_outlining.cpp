@@ -0,0 +1,351 @@
+/*******************************************************************
+
+ Module: Outlining of the loops into recursive functions, so that they
+ get summaries like any other function
+
+\*******************************************************************/
+
+#include "loop_outlining.h"
+#include "utils/naming_helpers.h"
+
+#include <analyses/dirty.h>
+#include <analyses/natural_loops.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/replace_symbol.h>
+#include <util/std_code.h>
+
+#include <algorithm>
+#include <map>
+
+namespace {
+typedef natural_loops_mutablet::natural_loopt loopt;
+
+// Instructions that can be moved to another function as they are
+bool is_movable(const goto_programt::instructiont & instruction)
+{
+  switch (instruction.type) {
+    case GOTO:
+    case ASSIGN:
+    case ASSUME:
+    case ASSERT:
+    case SKIP:
+    case LOCATION:
+    case DECL:
+    case DEAD:
+    case FUNCTION_CALL:
+    case OTHER:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Does the loop contain the header of another loop?
+bool is_innermost(const natural_loops_mutablet::loop_mapt::value_type & loop,
+                  const natural_loops_mutablet & loops)
+{
+  return std::none_of(loops.loop_map.begin(), loops.loop_map.end(),
+                      [&loop](const natural_loops_mutablet::loop_mapt::value_type & other) {
+                        return other.first != loop.first && loop.second.count(other.first) > 0;
+                      });
+}
+
+class loop_outlinert
+{
+public:
+  explicit loop_outlinert(goto_modelt & _goto_model) :
+    goto_model(_goto_model), ns(_goto_model.symbol_table) {}
+
+  bool outline(const irep_idt & function_id, goto_functionst::goto_functiont & function,
+               goto_programt::targett header, const loopt & loop);
+
+private:
+  goto_modelt & goto_model;
+  const namespacet ns;
+  unsigned counter {0};
+
+  irep_idt add_function_symbol(const irep_idt & function_id, const source_locationt & location,
+                               const code_typet & type);
+  symbol_exprt add_global(const irep_idt & loop_id, const symbolt & local);
+};
+
+irep_idt loop_outlinert::add_function_symbol(const irep_idt & function_id,
+                                             const source_locationt & location,
+                                             const code_typet & type)
+{
+  irep_idt loop_id;
+  do {
+    loop_id = id2string(function_id) + HifrogStringConstants::LOOP_FUNCTION + std::to_string(counter++);
+  } while (goto_model.symbol_table.has_symbol(loop_id));
+
+  const symbolt & function_symbol = ns.lookup(function_id);
+  symbolt symbol;
+  symbol.name = loop_id;
+  symbol.base_name = loop_id;
+  symbol.pretty_name = loop_id;
+  symbol.type = type;
+  symbol.mode = function_symbol.mode;
+  symbol.module = function_symbol.module;
+  symbol.location = location;
+  goto_model.symbol_table.add(symbol);
+  return loop_id;
+}
+
+// The global passing the value of the local between the loop and its function
+symbol_exprt loop_outlinert::add_global(const irep_idt & loop_id, const symbolt & local)
+{
+  symbolt symbol;
+  symbol.name = id2string(loop_id) + "::" + id2string(local.name);
+  symbol.base_name = local.base_name;
+  symbol.pretty_name = local.pretty_name;
+  symbol.type = local.type;
+  symbol.mode = local.mode;
+  symbol.module = local.module;
+  symbol.location = local.location;
+  symbol.is_static_lifetime = true;
+  symbol.is_lvalue = true;
+  symbol.is_state_var = true;
+  symbol.is_file_local = true;
+  goto_model.symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+}
+
+/*******************************************************************
+ Function: loop_outlinert::outline
+
+ Purpose: Moves the loop to a new function, if it is a contiguous range
+ of movable instructions starting at the header, with at most one exit
+ target and no local whose address is taken.
+\*******************************************************************/
+bool loop_outlinert::outline(
+  const irep_idt & function_id,
+  goto_functionst::goto_functiont & function,
+  goto_programt::targett header,
+  const loopt & loop)
+{
+  goto_programt & body = function.body;
+  goto_programt::targett last = header;
+  for (const auto & it : loop) {
+    if (it->location_number < header->location_number) {
+      return false;
+    }
+    if (it->location_number > last->location_number) {
+      last = it;
+    }
+  }
+  if (last->location_number - header->location_number + 1 != loop.size()) {
+    return false;
+  }
+  const goto_programt::targett after = std::next(last);
+
+  std::set<goto_programt::targett> exits;
+  for (auto it = header; it != after; ++it) {
+    if (!is_movable(*it)) {
+      return false;
+    }
+    // the header is the only entry
+    if (it != header && std::any_of(it->incoming_edges.begin(), it->incoming_edges.end(),
+                                    [&loop](goto_programt::targett source) { return loop.count(source) == 0; })) {
+      return false;
+    }
+    if (it->is_goto()) {
+      for (const auto & target : it->targets) {
+        if (loop.count(target) == 0) {
+          exits.insert(target);
+        }
+      }
+    }
+    if (it == last && !(it->is_goto() && it->guard.is_true())) {
+      exits.insert(after);
+    }
+  }
+  if (exits.size() > 1) {
+    return false;
+  }
+
+  // the locals of the loop: the ones shared with the rest of the function are passed through globals
+  find_symbols_sett inside, outside, declared, written;
+  for (auto it = body.instructions.begin(); it != body.instructions.end(); ++it) {
+    const bool in_loop = loop.count(it) > 0;
+    find_symbols(it->code, in_loop ? inside : outside);
+    find_symbols(it->guard, in_loop ? inside : outside);
+    if (!in_loop) { continue; }
+    if (it->is_decl()) {
+      declared.insert(to_code_decl(it->code).get_identifier());
+    }
+    else if (it->is_assign()) {
+      find_symbols(to_code_assign(it->code).lhs(), written);
+    }
+    else if (it->is_function_call()) {
+      find_symbols(to_code_function_call(it->code).lhs(), written);
+    }
+    else if (it->is_other()) {
+      find_symbols(it->code, written);
+    }
+  }
+  const dirtyt dirty(function);
+  std::vector<const symbolt *> shared;
+  for (const auto & id : inside) {
+    const symbolt * symbol = nullptr;
+    if (ns.lookup(id, symbol) || symbol->is_static_lifetime || symbol->is_type || symbol->type.id() == ID_code) {
+      continue;
+    }
+    if (dirty(id)) {
+      return false;
+    }
+    if (outside.count(id) > 0 || declared.count(id) == 0) {
+      shared.push_back(symbol);
+    }
+  }
+  std::sort(shared.begin(), shared.end(),
+            [](const symbolt * a, const symbolt * b) { return id2string(a->name) < id2string(b->name); });
+
+  const code_typet loop_type{code_typet::parameterst{}, empty_typet()};
+  const irep_idt loop_id = add_function_symbol(function_id, header->source_location, loop_type);
+  const symbol_exprt loop_function{loop_id, loop_type};
+  replace_symbolt replace;
+  std::vector<std::pair<symbol_exprt, symbol_exprt>> passed; // local, global
+  for (const symbolt * local : shared) {
+    passed.emplace_back(local->symbol_expr(), add_global(loop_id, *local));
+    replace.insert(passed.back().first, passed.back().second);
+  }
+
+  // The body of the new function: the loop, where the back edges call the function again
+  goto_programt loop_body;
+  std::map<goto_programt::targett, goto_programt::targett> copies;
+  for (auto it = header; it != after; ++it) {
+    auto copy = loop_body.add_instruction();
+    *copy = *it;
+    copy->incoming_edges.clear();
+    copies[it] = copy;
+  }
+  auto end = loop_body.add_instruction(END_FUNCTION);
+  end->code.set(ID_identifier, loop_id);
+  end->source_location = last->source_location;
+
+  for (auto it = header; it != after; ++it) {
+    auto copy = copies.at(it);
+    if ((copy->is_decl() || copy->is_dead()) && replace.replaces_symbol(copy->code.op0().get(ID_identifier))) {
+      // a shared local declared in the loop is a global now
+      if (copy->is_decl()) {
+        const exprt local = copy->code.op0();
+        copy->make_assignment(code_assignt(local, side_effect_expr_nondett(local.type(), copy->source_location)));
+      }
+      else {
+        copy->make_skip();
+      }
+    }
+    replace(copy->code);
+    replace(copy->guard);
+    if (!copy->is_goto()) { continue; }
+
+    const auto target = copy->get_target();
+    if (target == header) {
+      // back edge: the remaining iterations are done by the recursive call
+      const exprt guard = copy->guard;
+      auto call = loop_body.insert_after(copy);
+      code_function_callt call_code;
+      call_code.function() = loop_function;
+      call->make_function_call(call_code);
+      call->source_location = copy->source_location;
+      auto ret = loop_body.insert_after(call);
+      ret->make_goto(end);
+      ret->source_location = copy->source_location;
+      if (guard.is_true()) {
+        copy->make_skip();
+      }
+      else {
+        auto next = loop_body.insert_after(ret);
+        next->make_skip();
+        next->source_location = copy->source_location;
+        copy->make_goto(next, boolean_negate(guard));
+      }
+    }
+    else {
+      const auto copy_it = copies.find(target);
+      copy->targets.clear();
+      copy->targets.push_back(copy_it == copies.end() ? end : copy_it->second);
+    }
+  }
+
+  // The loop in the function: the values are passed in, the function is called and the values passed out
+  const source_locationt location = header->source_location;
+  const goto_programt::targett rest = std::next(header);
+  header->make_skip();
+  auto pos = header;
+  for (const auto & p : passed) {
+    pos = body.insert_after(pos);
+    pos->make_assignment(code_assignt(p.second, p.first));
+    pos->source_location = location;
+  }
+  pos = body.insert_after(pos);
+  code_function_callt call_code;
+  call_code.function() = loop_function;
+  pos->make_function_call(call_code);
+  pos->source_location = location;
+  for (const auto & p : passed) {
+    if (written.count(p.first.get_identifier()) == 0) { continue; }
+    pos = body.insert_after(pos);
+    pos->make_assignment(code_assignt(p.first, p.second));
+    pos->source_location = location;
+  }
+  if (exits.empty()) {
+    // the loop never terminates
+    pos = body.insert_after(pos);
+    pos->make_assumption(false_exprt());
+    pos->source_location = location;
+  }
+  else if (*exits.begin() != after) {
+    const auto exit = *exits.begin();
+    pos = body.insert_after(pos);
+    pos->make_goto(exit);
+    pos->source_location = location;
+  }
+  body.instructions.erase(rest, after);
+
+  auto & loop_goto_function = goto_model.goto_functions.function_map[loop_id];
+  loop_goto_function.type = loop_type;
+  loop_goto_function.body.swap(loop_body);
+  return true;
+}
+
+/*******************************************************************
+ Function: outline_loops
+
+ Purpose: Outlines the loops until a fixpoint: an outer loop calling the
+ function of its inner loop can be outlined in the next round
+\*******************************************************************/
+unsigned outline_loops(goto_modelt & goto_model, message_handlert & message_handler)
+{
+  messaget msg{message_handler};
+  loop_outlinert outliner{goto_model};
+  unsigned outlined = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    goto_model.goto_functions.update();
+    std::vector<irep_idt> function_ids;
+    for (const auto & entry : goto_model.goto_functions.function_map) {
+      if (entry.second.body_available() && entry.first != goto_functionst::entry_point() &&
+          !is_cprover_initialize_method(id2string(entry.first))) {
+        function_ids.push_back(entry.first);
+      }
+    }
+    for (const auto & function_id : function_ids) {
+      auto & function = goto_model.goto_functions.function_map.at(function_id);
+      natural_loops_mutablet loops(function.body);
+      for (const auto & loop : loops.loop_map) {
+        if (is_innermost(loop, loops) && outliner.outline(function_id, function, loop.first, loop.second)) {
+          ++outlined;
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+  goto_model.goto_functions.update();
+  msg.status() << "Outlined loops: " << outlined << msg.eom;
+  return outlined;
+}
@@ -0,0 +1,24 @@
+/*******************************************************************
+
+ Module: Outlining of the loops into recursive functions, so that they
+ get summaries like any other function
+
+ A loop becomes a function performing its remaining iterations; the
+ back edge is a call of the function itself. The recursion is handled
+ as usual: unwound up to the bound and havocked at the bound, so the
+ summaries of these functions hold for any number of iterations.
+ The locals the loop shares with the rest of its function are passed
+ through new globals, copied in before the call and out after it.
+
+\*******************************************************************/
+
+#ifndef HIFROG_LOOP_OUTLINING_H
+#define HIFROG_LOOP_OUTLINING_H
+
+#include <goto-programs/goto_model.h>
+#include <util/message.h>
+
+// Outlines the innermost loops first; returns the number of outlined loops
+unsigned outline_loops(goto_modelt & goto_model, message_handlert & message_handler);
+
+#endif //HIFROG_LOOP_OUTLINING_H
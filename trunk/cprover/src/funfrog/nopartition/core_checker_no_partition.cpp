@@ -40,6 +40,7 @@ bool core_checkert::assertion_holds_smt_no_partition(
   symex_no_partitiont symex {options, *worklist, ns.get_symbol_table(), equation, message_handler,
                              get_main_function() ,!no_slicing_option};
   symex.setup_unwind(options.get_unsigned_int_option(HiFrogOptions::UNWIND));
+  symex.setup_unwind(unwind_bounds);
 
 
   prepare_formula_no_partitiont prop = prepare_formula_no_partitiont(
@@ -56,6 +57,7 @@ bool core_checkert::assertion_holds_smt_no_partition(
     end = (count == 1)
           ? symex.prepare_SSA(assertion, omega.get_goto_functions())
           : symex.refine_SSA (assertion, false); // Missing sets of refined functions, TODO
+    loop_bound_reached = loop_bound_reached || symex.is_loop_bound_reached();
 
     //LA: good place?
 //    if(options.get_bool_option("list-templates"))
@@ -12,6 +12,7 @@
 
 #include "hifrog_symex_target_equation_no_partition.h"
 #include "../assertion_info.h"
+#include "../unwind_bounds.h"
 
 bool symex_no_partitiont::prepare_SSA(const assertion_infot &assertion, const goto_functionst& goto_functions)
 {
@@ -110,12 +111,26 @@ bool symex_no_partitiont::process_planned(statet &state, const goto_functionst &
     return false;
 }
 
-bool symex_no_partitiont::get_unwind(const symex_targett::sourcet & source, const statet::call_stackt &context, unsigned unwind) {
+bool symex_no_partitiont::should_stop_unwind(const symex_targett::sourcet & source, const statet::call_stackt &context, unsigned unwind) {
     // returns true if we should not continue unwinding
-    // for support of different bounds in different loops, see how it's done in symex_bmct
+    if (unwind_bounds) {
+        return unwind >= unwind_bounds->get_loop_bound(id2string(source.pc->function), source.pc->source_location,
+                                                       source.pc->loop_number);
+    }
     return unwind >= max_unwind;
 }
 
+void symex_no_partitiont::loop_bound_exceeded(statet &state, const exprt &guard) {
+    if (!state.guard.is_false()) {
+        loop_bound_reached = true;
+        if (unwind_bounds) {
+            unwind_bounds->loop_bound_exceeded(id2string(state.source.pc->function), state.source.pc->source_location,
+                                               state.source.pc->loop_number);
+        }
+    }
+    goto_symext::loop_bound_exceeded(state, guard);
+}
+
 symex_no_partitiont::symex_no_partitiont(const optionst & _options, path_storaget & _path_storage,
                                          const symbol_tablet & _outer_symbol_table,
                                          hifrog_symex_target_equationt & _target, message_handlert & _message_handler,
@@ -11,6 +11,7 @@
 class hifrog_symex_target_equationt;
 class assertion_infot;
 class path_storaget;
+class unwind_boundst;
 
 class symex_no_partitiont : public goto_symext {
 public:
@@ -44,14 +45,21 @@ public:
     }
 
     void setup_unwind(unsigned int max_unwind) { this->max_unwind = max_unwind; }
+    // Per-loop bounds of the automatic unwinding, instead of the single bound
+    void setup_unwind(unwind_boundst * unwind_bounds) { this->unwind_bounds = unwind_bounds; }
+
+    // False if the result does not depend on the unwind bound of the loops
+    bool is_loop_bound_reached() const { return loop_bound_reached; }
 
 // Data Members    
     std::map<irep_idt, std::string> guard_expln;
 protected:
-    bool get_unwind(
+    bool should_stop_unwind(
     const symex_targett::sourcet &source,
     const statet::call_stackt &context,
-    unsigned unwind);
+    unsigned unwind) override;
+
+    void loop_bound_exceeded(statet &state, const exprt &guard) override;
 
 private:
     // to be able to start with a fresh statePrt
@@ -74,6 +82,8 @@ private:
     }
     
     unsigned int max_unwind = 1;
+    bool loop_bound_reached = false;
+    unwind_boundst * unwind_bounds = nullptr;
     // Store for the symex result
     hifrog_symex_target_equationt &equation;
     
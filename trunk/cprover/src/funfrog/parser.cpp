@@ -3,6 +3,25 @@
 #include <remove_asm.h>
 #include <util/exit_codes.h>
 #include <goto-programs/rewrite_union.h>
+#include <funfrog/utils/parallel_utils.h>
+#include <funfrog/loop_outlining.h>
+#include <algorithm>
+
+/*******************************************************************\
+ Function: parse_preprocess_threads
+
+ Purpose: The number of threads given to --preprocess-threads; 0 if the
+ value is not a positive number (of at most 9 digits, no overflow)
+\*******************************************************************/
+static unsigned parse_preprocess_threads(const std::string & value)
+{
+  if (value.empty() || value.size() > 9
+      || !std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+    return 0;
+  }
+  return unsafe_string2unsigned(value);
+}
+
 /*******************************************************************\
 
  Function:
@@ -43,7 +62,8 @@ bool parser_baset::validate_input_options()
   else if(!cmdline.isset("all-claims") &&
           !cmdline.isset("claimset") &&
           !cmdline.isset("claims-order") &&
-          !cmdline.isset("claim"))
+          !cmdline.isset("claim") &&
+          !cmdline.isset("shared-symex"))
   {
     //fixme in upprover we don't set any claim. if no VCC found (unreachable assertion) report safe
     error_interface("A specific claim is not set, nor any other claim specification is set.");
@@ -51,6 +71,39 @@ bool parser_baset::validate_input_options()
     claim_user_nr = 1; // Set as defualt
   }
   
+  if (cmdline.isset("unwind-deepening")) {
+    unsigned min_bound, max_bound, step;
+    if (!parse_unwind_deepening(cmdline.get_value("unwind-deepening"), min_bound, max_bound, step)) {
+      error_interface("Error: invalid --unwind-deepening " + cmdline.get_value("unwind-deepening")
+                      + ". Please re-run with min:max:step where 0 < min <= max and step > 0!");
+      return false;
+    }
+  }
+
+  if (cmdline.isset("preprocess-threads")
+      && parse_preprocess_threads(cmdline.get_value("preprocess-threads")) == 0) {
+    error_interface("Error: invalid --preprocess-threads " + cmdline.get_value("preprocess-threads")
+                    + ". Please re-run with a positive number of threads!");
+    return false;
+  }
+
+  if (cmdline.isset("unwind-auto")) {
+    if (options.get_unsigned_int_option("unwind-auto") == 0) {
+      error_interface("Error: invalid --unwind-auto " + cmdline.get_value("unwind-auto")
+                      + ". Please re-run with a positive maximal bound!");
+      return false;
+    }
+    if (cmdline.isset("unwind-deepening")) {
+      error_interface("--unwind-auto cannot be combined with --unwind-deepening.");
+      return false;
+    }
+    // the theory refinement does not report the loops cut by their bound
+    if (cmdline.isset("theoref")) {
+      error_interface("--unwind-auto is not supported with --theoref.");
+      return false;
+    }
+  }
+
   // option unsupported in cuf or prop
   if ((options.get_option("logic") == "prop") || (options.get_option("logic") == "qfcuf"))
   {
@@ -68,6 +121,10 @@ bool parser_baset::validate_input_options()
 #endif
   }
   
+  if (cmdline.isset("interval-invariants") && cmdline.isset("save-summaries")) {
+    status_interface("Warning: --save-summaries is ignored with --interval-invariants");
+  }
+
   // If we set bitwidth, check it sets right, it will be by default 8
   if ((options.get_option("logic") == "qfcuf")  // bitwidth exists only in cuf
       || (options.get_option("load-sum-model").size()!=0)) // Or for latticeref
@@ -338,7 +395,16 @@ void parser_baset::set_options_All(const cmdlinet &cmdline)
   //options.set_option("list-templates", cmdline.isset("list-templates")); // FIXME
   options.set_option("no-cex-model", cmdline.isset("no-cex-model"));
   options.set_option("no-sum-refine", cmdline.isset("no-sum-refine"));
+  options.set_option("lazy-call-tree", cmdline.isset("lazy-call-tree"));
+  options.set_option("reduce-iface", cmdline.isset("reduce-iface"));
+  options.set_option("stream-conversion", cmdline.isset("stream-conversion"));
+  options.set_option("low-memory", cmdline.isset("low-memory"));
+  options.set_option("replay-cex", cmdline.isset("replay-cex"));
+  options.set_option("interval-invariants", cmdline.isset("interval-invariants"));
+  options.set_option("shared-symex", cmdline.isset("shared-symex"));
+  options.set_option("outline-loops", cmdline.isset("outline-loops"));
   options.set_option("reduce-proof", cmdline.isset("reduce-proof"));
+  options.set_option("minimize-summaries", cmdline.isset("minimize-summaries"));
   options.set_option("partial-loops", cmdline.isset("partial-loops"));
 
 #ifdef PRODUCE_PROOF
@@ -424,9 +490,17 @@ void parser_baset::set_options_All(const cmdlinet &cmdline)
   //}
   if (cmdline.isset("unwind")) {
     options.set_option("unwind", cmdline.get_value("unwind"));
+  } else if (cmdline.isset("unwind-auto")) { // the initial bound of the loops
+    options.set_option("unwind", 2);
   } else { // Set to max - KE: find a better way to do so
     options.set_option("unwind", std::to_string(std::numeric_limits<unsigned int>::max()));
   }
+  if (cmdline.isset("unwind-deepening")) {
+    options.set_option("unwind-deepening", cmdline.get_value("unwind-deepening"));
+  }
+  if (cmdline.isset("unwind-auto")) {
+    options.set_option("unwind-auto", cmdline.get_value("unwind-auto"));
+  }
   //if (cmdline.isset("unwindset")) {
   //  options.set_option("unwindset", cmdline.get_value("unwindset"));
   //}
@@ -442,7 +516,10 @@ void parser_baset::set_options_All(const cmdlinet &cmdline)
   if (cmdline.isset("claims-opt")) { // In Help Menu
     options.set_option("claims-opt", cmdline.get_value("claims-opt"));
   }
-  if (cmdline.isset("save-summaries")) {
+  if (cmdline.isset("interval-invariants")) {
+    // the invariants constrain the partitions of the callers, whose summaries then hold for this program only
+    options.set_option("save-summaries", "");
+  } else if (cmdline.isset("save-summaries")) {
     options.set_option("save-summaries", cmdline.get_value("save-summaries"));
   } else {
     options.set_option("save-summaries", "__summaries");
@@ -537,6 +614,73 @@ void parser_baset::eval_verbosity()
   ui_message_handler.set_verbosity(v);
 }
 
+namespace {
+  std::vector<goto_functionst::function_mapt::value_type *> function_list(goto_functionst & goto_functions)
+  {
+    std::vector<goto_functionst::function_mapt::value_type *> functions;
+    functions.reserve(goto_functions.function_map.size());
+    for (auto & entry : goto_functions.function_map) {
+      functions.push_back(&entry);
+    }
+    return functions;
+  }
+}
+
+/*******************************************************************
+
+ Function: preprocess_functions_parallel
+
+ Purpose: The function-local passes of process_goto_program (vectors,
+ complex numbers, unions, generic checks and float adjustment) run on
+ a pool of threads, one function at a time. The workers only read the
+ symbol table; its own rewriting is done up front, in this thread, and
+ then it is frozen.
+ With pointer checks, goto_check needs the allocations of the whole
+ program and stays sequential.
+
+\*******************************************************************/
+static void preprocess_functions_parallel(goto_modelt &goto_model, const optionst &options,
+                                          bool adjust_floats, unsigned threads, messaget &msg)
+{
+  remove_vector(goto_model.symbol_table);
+  remove_complex(goto_model.symbol_table);
+  
+  // All the workers copy types and values out of the symbol table; copies
+  // of frozen ireps leave the (atomic) reference counts alone
+  for (auto it = goto_model.symbol_table.begin(); it != goto_model.symbol_table.end(); ++it) {
+    symbolt & symbol = it.get_writeable_symbol();
+    symbol.type.freeze();
+    symbol.value.freeze();
+    symbol.location.freeze();
+  }
+  
+  const namespacet ns(goto_model.symbol_table);
+  const bool sequential_check = options.get_bool_option("pointer-check");
+  msg.status() << "Generic Property Instrumentation (" << threads << " threads)" << msg.eom;
+  
+  auto functions = function_list(goto_model.goto_functions);
+  parallel_for_each(functions, threads,
+      [&](goto_functionst::function_mapt::value_type * function) {
+        auto & goto_function = function->second;
+        remove_vector(goto_function);
+        remove_complex(goto_function);
+        rewrite_union(goto_function);
+        if (!sequential_check) {
+          goto_check(ns, options, ns.lookup(function->first).mode, goto_function);
+          if (adjust_floats) {
+            adjust_float_expressions(goto_function, ns);
+          }
+        }
+      });
+  
+  if (sequential_check) {
+    goto_check(ns, options, goto_model.goto_functions);
+    if (adjust_floats) {
+      adjust_float_expressions(goto_model.goto_functions, ns);
+    }
+  }
+}
+
 /*******************************************************************
 
  Function: standalone process_goto_program
@@ -586,22 +730,45 @@ bool process_goto_program(goto_modelt &goto_model,const cmdlinet &cmdline,
     // instrument library preconditions
     instrument_preconditions(goto_model);
     
-    // remove returns, gcc vectors, complex
-    // remove_returns(symbol_table, goto_functions); //KE: causes issues with hifrog/upprover
-    remove_vector(goto_model);
-    remove_complex(goto_model);
-    rewrite_union(goto_model);
-    
-    // add generic checks
-    msg.status() << "Generic Property Instrumentation" << msg.eom;
-    goto_check(options, goto_model);
+    if (cmdline.isset("drop-unused-functions"))
+    {
+      // the functions not called from the entry point (all calls are direct by now)
+      // are dropped before the function-local passes, which dominate large programs
+      msg.status() << "Removal of unused functions" << msg.eom;
+      remove_unused_functions(goto_model, msg.get_message_handler());
+    }
     
     //HiFrog: We remove built-ins (e.g., CPROVER_rounding_mode) from smt logics
     //For handling floats symbol CPROVER_rounding_mode should be added only in bv
-    if (cmdline.isset(HiFrogOptions::LOGIC.c_str()))
-    {
-      if (cmdline.get_value(HiFrogOptions::LOGIC.c_str()) == "prop")
-      {
+    const bool adjust_floats = cmdline.isset(HiFrogOptions::LOGIC.c_str())
+        && cmdline.get_value(HiFrogOptions::LOGIC.c_str()) == "prop";
+    
+    // an invalid value is reported by validate_input_options, which stops the run
+    unsigned preprocess_threads = cmdline.isset("preprocess-threads")
+        ? std::max(parse_preprocess_threads(cmdline.get_value("preprocess-threads")), 1u) : 1;
+#ifndef IREP_THREAD_SAFE
+    if (preprocess_threads > 1) {
+      msg.warning() << "Parallel preprocessing needs a build with thread-safe ireps;"
+                    << " using a single thread" << msg.eom;
+      preprocess_threads = 1;
+    }
+#endif
+    
+    if (preprocess_threads > 1) {
+      preprocess_functions_parallel(goto_model, options, adjust_floats, preprocess_threads, msg);
+    }
+    else {
+      // remove returns, gcc vectors, complex
+      // remove_returns(symbol_table, goto_functions); //KE: causes issues with hifrog/upprover
+      remove_vector(goto_model);
+      remove_complex(goto_model);
+      rewrite_union(goto_model);
+      
+      // add generic checks
+      msg.status() << "Generic Property Instrumentation" << msg.eom;
+      goto_check(options, goto_model);
+      
+      if (adjust_floats) {
         adjust_float_expressions(goto_model);
       }
     }
@@ -630,6 +797,11 @@ bool process_goto_program(goto_modelt &goto_model,const cmdlinet &cmdline,
       //call unwind function
       goto_unwind(goto_model, unwindset, goto_unwindt::unwind_strategyt::ASSUME);
     }
+    else if (cmdline.isset("outline-loops"))
+    {
+      // loops become recursive functions with their own summaries
+      outline_loops(goto_model, msg.get_message_handler());
+    }
     // recalculate numbers, etc.
     goto_model.goto_functions.update();
     
@@ -637,7 +809,16 @@ bool process_goto_program(goto_modelt &goto_model,const cmdlinet &cmdline,
     goto_model.goto_functions.compute_loop_numbers();
   
     // remove any skips introduced since coverage instrumentation
-    remove_skip(goto_model);
+    if (preprocess_threads > 1) {
+      auto functions = function_list(goto_model.goto_functions);
+      parallel_for_each(functions, preprocess_threads,
+          [](goto_functionst::function_mapt::value_type * function) {
+            remove_skip(function->second.body);
+          });
+    }
+    else {
+      remove_skip(goto_model);
+    }
     goto_model.goto_functions.update();
     
     //here is not a good place to put the actual unwinding.
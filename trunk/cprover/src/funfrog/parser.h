@@ -36,6 +36,7 @@
 #include <goto-programs/initialize_goto_model.h>
 #include <goto-programs/read_goto_binary.h>
 #include <goto-programs/instrument_preconditions.h>
+#include <goto-programs/remove_unused_functions.h>
 #include <goto-programs/show_symbol_table.h>
 #include <goto-programs/show_goto_functions.h>
 #include <goto-programs/show_properties.h>
@@ -44,6 +44,14 @@ void parser_hifrogt::help()
   "                               (treshold = number of SSA steps)\n"
   "                               and check stronger claims at once\n"
   "--unwind <bound>               loop unwind bound\n"
+  "--unwind-deepening <min>:<max>:<step>\n"
+  "                               check with increasing unwind bounds until a claim\n"
+  "                               fails or no loop reaches the bound (each bound\n"
+  "                               is checked from scratch)\n"
+  "--unwind-auto <max>            start with --unwind (default 2) and raise the bounds\n"
+  "                               of the loops cut by them up to <max>; the bounds\n"
+  "                               are stored next to the summaries (not with\n"
+  "                               --theoref or --unwind-deepening)\n"
   "--partial-loops                do not forbid paths with unsufficient loop unwinding (due to unwind bound)\n"
   "--type-constraints             LRA's and LIA's basic constraints on numerical data type\n"
   "                                 0 - no additional constraints,\n"
@@ -63,7 +71,32 @@ void parser_hifrogt::help()
   #ifdef PRODUCE_PROOF
   "--no-itp                       do not construct summaries (just report SAFE/BUG)\n"
   #endif
-  "--no-partitions                do not use partitions to create the BMC formula\n\n"
+  "--no-partitions                do not use partitions to create the BMC formula\n"
+  "--lazy-call-tree               create the call tree nodes of functions without\n"
+  "                               assertions only when they get inlined\n"
+  "--reduce-iface                 keep in the function interfaces only the modified\n"
+  "                               globals that are read after the call returns\n"
+  "--preprocess-threads <n>       run the function-local preprocessing passes\n"
+  "                               on <n> threads (needs thread-safe ireps)\n"
+  "--stream-conversion            convert the finished partitions to SMT on a separate\n"
+  "                               thread during symex (needs thread-safe ireps)\n"
+  "--low-memory                   release the SSA steps once they are converted\n"
+  "                               (the error trace then needs a second run)\n\n"
+  "--replay-cex                   replay counterexamples of over-approximating\n"
+  "                               encodings on the concrete interpreter, to\n"
+  "                               report them as real bugs if reproduced\n\n"
+  "--interval-invariants          constrain the call sites by the intervals found\n"
+  "                               by abstract interpretation, abstract the calls\n"
+  "                               with the intervals at their return and prune\n"
+  "                               the unreachable ones (the summaries are then\n"
+  "                               not saved)\n\n"
+  "--shared-symex                 check all the claims on one SSA form, switching\n"
+  "                               off the violated ones between solver calls\n\n"
+  "--outline-loops                turn the loops into recursive functions, whose\n"
+  "                               summaries hold for any number of iterations\n\n"
+  "--drop-unused-functions        drop the functions not reachable from the entry\n"
+  "                               point before the preprocessing (the claims are\n"
+  "                               numbered in the remaining functions)\n\n"
   "--solver                       SMT solving option, solver type:\n"
   "                                 osmt - use OpenSMT2 solver,\n"
   "                                 z3   - use Z3 solver\n"
@@ -105,6 +138,8 @@ void parser_hifrogt::help()
   "--reduce-proof                 enable Proof Reduction\n"
   "--reduce-proof-graph           number of graph traversals per reduction iteration\n"
   "--reduce-proof-loops           number of reduction iterations\n"
+  "--minimize-summaries           drop summary conjuncts implied by the rest\n"
+  "                               before the summary is stored\n"
   #endif
 
   #ifdef DISABLE_OPTIMIZATIONS
@@ -256,12 +291,30 @@ int parser_hifrogt::doit()
   
   if(validate_input_options()) {
     //perform standalone check for stream of assertions in a specific source file
-    check_claims(goto_model,
-                 claim_checkmap,
-                 claim_numbers,
-                 options,
-                 ui_message_handler,
-                 claim_user_nr);
+    if (cmdline.isset("unwind-auto")) {
+      check_claims_auto(goto_model,
+                        claim_checkmap,
+                        claim_numbers,
+                        options,
+                        ui_message_handler,
+                        claim_user_nr);
+    }
+    else if (cmdline.isset("unwind-deepening")) {
+      check_claims_deepening(goto_model,
+                               claim_checkmap,
+                               claim_numbers,
+                               options,
+                               ui_message_handler,
+                               claim_user_nr);
+    }
+    else {
+      check_claims(goto_model,
+                   claim_checkmap,
+                   claim_numbers,
+                   options,
+                   ui_message_handler,
+                   claim_user_nr);
+    }
   }
   else {
     status_interface("Please check --help to revise the user's options ");
@@ -35,16 +35,17 @@ Module: Command Line Parsing
   "(theoref)(force)(custom):(heuristic):(bitwidth):" \
   "(sum-theoref)" \
   "(save-queries)(save-change-impact):" \
-  "(tree-interpolants)(proof-trans):(reduce-proof)(reduce-proof-time):(reduce-proof-loops):(reduce-proof-graph):(color-proof):" \
+  "(tree-interpolants)(proof-trans):(reduce-proof)(reduce-proof-time):(reduce-proof-loops):(reduce-proof-graph):(color-proof):(minimize-summaries):" \
   "(random-seed):(no-partitions)(no-itp)(verbose-solver):" \
   "(itp-algorithm): (itp-uf-algorithm): (itp-lra-algorithm):(itp-lra-factor): (check-itp): (part-itp):" \
-  "(unwind):(unwindset):" \
+  "(unwind):(unwindset):(unwind-deepening):(unwind-auto):" \
   "(type-constraints):(type-byte-constraints):" \
   "(inlining-limit):(testclaim):" \
   "(pobj)(eq)(neq)(ineq)" \
   "(no-error-trace)" \
   "(no-cex-model)" \
   "(no-sum-refine)" \
+  "(lazy-call-tree)(reduce-iface)(preprocess-threads):(stream-conversion)(low-memory)(replay-cex)(interval-invariants)(shared-symex)(outline-loops)(drop-unused-functions)" \
   "(refine-mode):(init-mode):(logic):(list-templates)"\
   "(solver):(dump-query)(dump-pre-query)(dump-SSA-tree)(dump-query-name):"\
   "(partial-loops)" \
@@ -25,7 +25,7 @@ public:
   
   partitiont(partition_idt _parent_id, partition_ifacet& _partition_iface) :
           ignore(false),
-//        converted(false),
+          converted(false),
           partition_summaryID(0),
           parent_id(_parent_id),
           representation(partition_representation::NONE),
@@ -66,18 +66,16 @@ public:
   partition_ifacet& get_iface() { return *partition_iface; }
   const partition_ifacet& get_iface() const { return *partition_iface; }
 
+  // Index of the first SSA step (in the step arena of the equation) corresponding to this partition
   unsigned start_idx=0;
   // Index after the last SSA corresponding to this partition
   unsigned end_idx=0;
-  symex_target_equationt::SSA_stepst::iterator start_it;
-  // Iterator after the last SSA corresponding to this partition
-  symex_target_equationt::SSA_stepst::iterator end_it;
 
   // =========== PARTITION FLAGS ==============================
   // if true, this partition was found to be redundant in slicing and should not be present in the resulting formula
   bool ignore;
   // if true, this partition had already its current representation converted
-//  bool converted;
+  bool converted;
 
   bool has_ssa_representation() const {return (representation & partition_representation::SSA) == partition_representation::SSA;}
   bool is_real_ssa_partition() const {return has_ssa_representation() && !has_abstract_representation();}
@@ -5,6 +5,7 @@
 #ifndef HIFROG_PARTITION_FWD_H
 #define HIFROG_PARTITION_FWD_H
 
+#include <deque>
 #include <list>
 #include <util/irep.h>
 
@@ -14,7 +15,9 @@ typedef int partition_idt;
 typedef std::list<partition_idt> partition_idst;
 typedef std::map<irep_idt, partition_idt> partition_mapt;
 typedef std::list<unsigned> partition_locst;
-typedef std::vector<partitiont> partitionst;
+// references to the partitions stay valid while new ones are added
+// (the streaming conversion converts them while symex adds the others)
+typedef std::deque<partitiont> partitionst;
 
 const int NO_PARTITION_ID = -1;
 
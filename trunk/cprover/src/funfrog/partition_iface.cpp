@@ -38,4 +38,3 @@ std::vector<symbol_exprt> partition_ifacet::get_iface_symbols() const {
     }
     return iface_symbols;
 }
-
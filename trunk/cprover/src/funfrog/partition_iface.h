@@ -34,6 +34,9 @@ public:
   std::vector<symbol_exprt> argument_symbols;
   std::vector<symbol_exprt> in_arg_symbols;
   std::vector<symbol_exprt> out_arg_symbols;
+  // Values of argument_symbols known at the call site (nil if unknown),
+  // used to specialize the summary of the call to its constant actuals
+  std::vector<exprt> argument_values;
   symbol_exprt retval_symbol;
   symbol_exprt retval_tmp;
   symbol_exprt callstart_symbol;
@@ -59,11 +62,16 @@ public:
   std::vector<unsigned> AB_vars;
 
   std::vector<symbol_exprt> get_iface_symbols() const;
+
+  bool has_known_value(std::size_t arg_idx) const {
+    return arg_idx < argument_values.size() && argument_values[arg_idx].is_not_nil();
+  }
   
   void share_symbols(const partition_ifacet& other) {
     argument_symbols = other.argument_symbols;
     in_arg_symbols = other.in_arg_symbols;
     out_arg_symbols = other.out_arg_symbols;
+    argument_values = other.argument_values;
     retval_symbol = other.retval_symbol;
     retval_tmp = other.retval_tmp;
     callstart_symbol = other.callstart_symbol;
@@ -80,12 +80,9 @@ Function: partitioning_slicet::slice
 void partitioning_slicet::slice(partitioning_target_equationt & equation, const summary_storet & summary_store)
 {
   // Mark assignments as ignored
-  for(symex_target_equationt::SSA_stepst::iterator it = 
-          equation.SSA_steps.begin();
-          it!=equation.SSA_steps.end();
-          ++it) {
+  for(auto & step : equation.get_SSA_steps()) {
     // We can only slice assignments
-    it->ignore = it->is_assignment();
+    step.ignore = step.is_assignment();
   }
   //SA: Due to crash in upprover in ex21-upg3.c. The problem is it gets ignored unwantedly.
 //  for (auto & partition : equation.get_partitions())
@@ -169,7 +166,8 @@ void partitioning_slicet::slice(partitioning_target_equationt & equation, const
             //partition.partition_summary_ID_set.insert(sumID);
             partition.partition_summaryID = sumID;
             for (unsigned idx = 0; idx < partition_iface.argument_symbols.size(); ++idx) {
-                if (summary.usesVar(idx)) {
+                // arguments with a value known at the call site are substituted in the summary
+                if (summary.usesVar(idx) && !partition_iface.has_known_value(idx)) {
                     get_symbols(partition_iface.argument_symbols[idx], depends);
                 }
             }
@@ -187,8 +185,8 @@ void partitioning_slicet::slice(partitioning_target_equationt & equation, const
       continue;
     
     bool ignore = true;
-    for(auto it = partition.start_it; it != partition.end_it; ++it) {
-      if (!it->ignore) {
+    for(const auto & step : equation.get_partition_steps(partition)) {
+      if (!step.ignore) {
         ignore = false;
         break;
       }
@@ -228,8 +226,9 @@ void partitioning_slicet::prepare_maps(partitioning_target_equationt &equation)
       continue;
 
     // Analyze the SSA steps
-    for (symex_target_equationt::SSA_stepst::iterator it2 = it->start_it;
-            it2 != it->end_it;
+    auto const partition_steps = equation.get_partition_steps(*it);
+    for (auto it2 = partition_steps.begin();
+            it2 != partition_steps.end();
             ++it2) {
       if (it2->is_assignment()) {
         prepare_assignment(*it2);
@@ -11,8 +11,12 @@
 #include "summary_store.h"
 #include "conversion_utils.h"
 #include "interface/solver/interpolating_solver.h"
+#include "interface/solver/solver.h"
+
+#include <util/expr_iterator.h>
 
 #include <numeric>
+#include <unordered_map>
 #include <algorithm>
 #include <iostream>
 
@@ -56,6 +60,8 @@ partitioning_target_equationt::partitioning_target_equationt(
  \*******************************************************************/
 partition_idt partitioning_target_equationt::reserve_partition(partition_ifacet& partition_iface)
 {
+    // the conversion thread may be reading the partitions
+    std::lock_guard<std::mutex> lock{structure_mutex};
     partition_idt new_id = partitions.size();
     partition_idt parent_id = partition_iface.parent_id;
 
@@ -69,6 +75,9 @@ partition_idt partitioning_target_equationt::reserve_partition(partition_ifacet&
     if (parent_id != NO_PARTITION_ID) {
         partitions[parent_id].add_child_partition(new_id, partition_iface.call_loc);
     }
+    else if (streaming) {
+        stream_roots.push_back(new_id);
+    }
     partition_iface.partition_id = new_id;
 
     return new_id;
@@ -82,6 +91,7 @@ void partitioning_target_equationt::refine_partition(partition_idt partition_id)
     }
     partition.remove_abstract_representation();
     partition.partition_summaryID = 0;
+    partition.converted = false;
 }
 
 
@@ -136,6 +146,9 @@ void partitioning_target_equationt::fill_summary_partition(partition_idt partiti
     sum_partition.add_summary_representation();
 
     sum_partition.partition_summaryID = sum_ID;
+    if (streaming) {
+        partition_finished(partition_id);
+    }
 }
 
 /*******************************************************************
@@ -145,11 +158,6 @@ void partitioning_target_equationt::fill_summary_partition(partition_idt partiti
  \*******************************************************************/
 
 void partitioning_target_equationt::prepare_partitions() { // for hifrog only
-    // Fill in the partition start and end iterator for easier access during
-    // the conversion process
-    unsigned idx = 0;
-    SSA_stepst::iterator ssa_it = SSA_steps.begin();
-
     // The last partition has an undefined end, fix it!
     close_current_partition();
 
@@ -163,24 +171,39 @@ void partitioning_target_equationt::prepare_partitions() { // for hifrog only
         return const_partitions[i1].start_idx < const_partitions[i2].start_idx;
     });
 
+    unsigned idx = 0;
     for (auto it = indices.begin(); it != unprocessed_it; ++it) {
         auto & partition = partitions[*it];
         assert(idx == partition.start_idx);
-        bool ignore = true;
-
-        partition.start_it = ssa_it;
-
-        while (idx != partition.end_idx) {
-            assert(ssa_it != SSA_steps.end());
-            ignore &= ssa_it->ignore;
-            ++ssa_it;
-            ++idx;
+        assert(partition.end_idx <= SSA_step_arena.size());
+        idx = partition.end_idx;
+        // When streaming, this was done on closing the partition and the
+        // partition might be being converted now
+        if (!streaming) {
+            compute_partition_ignore(partition);
         }
-        partition.end_it = ssa_it;
-        partition.ignore = ignore & !partition.get_iface().assertion_in_subtree;
     }
 }
 
+void partitioning_target_equationt::compute_partition_ignore(partitiont & partition) {
+    bool ignore = true;
+    for (const auto & step : get_partition_steps(partition)) {
+        ignore &= step.ignore;
+    }
+    partition.ignore = ignore & !partition.get_iface().assertion_in_subtree;
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::store_SSA_steps
+
+ Purpose: Moves the SSA steps generated by symex so far to the step arena.
+ The base class appends the steps to its list; we keep only the steps of
+ the currently generated partition there.
+ \*******************************************************************/
+void partitioning_target_equationt::store_SSA_steps() {
+    SSA_step_arena.append(SSA_steps);
+}
+
 /*******************************************************************
  Function: partitioning_target_equationt::prepare_SSA_exec_order
 
@@ -197,10 +220,8 @@ void partitioning_target_equationt::prepare_SSA_exec_order(
 		const partitiont& partition) {
     partition_locst::const_iterator loc_it = partition.child_locs.begin();
     partition_idst::const_iterator id_it = partition.child_ids.begin();
-    unsigned SSA_idx = partition.start_idx;
 
-    for (SSA_stepst::iterator it = partition.start_it; 
-        it != partition.end_it; ++it, ++SSA_idx) {
+    for (unsigned SSA_idx = partition.start_idx; SSA_idx != partition.end_idx; ++SSA_idx) {
         while (loc_it != partition.child_locs.end() && *loc_it == SSA_idx) {
             // Process the call first
             const partitiont& partition = partitions[*id_it];
@@ -212,9 +233,9 @@ void partitioning_target_equationt::prepare_SSA_exec_order(
             ++id_it;
         }
         // Add current step
-        SSA_steps_exec_order.push_back(&*it);
+        SSA_steps_exec_permutation.push_back(SSA_idx);
     }
-    while (loc_it != partition.child_locs.end() && *loc_it == SSA_idx) {
+    while (loc_it != partition.child_locs.end() && *loc_it == partition.end_idx) {
         // Process the call first
         const partitiont& partition = partitions[*id_it];
 
@@ -244,6 +265,8 @@ const partitiont* partitioning_target_equationt::find_target_partition(
                     && step.cond_expr.op1().id() == ID_symbol)) {
         irep_idt id = step.cond_expr.id() == ID_symbol ? step.cond_expr.get(
                         ID_identifier) : step.cond_expr.op1().get(ID_identifier);
+        // symex may be adding partitions (streaming conversion)
+        std::lock_guard<std::mutex> lock{structure_mutex};
         partition_mapt::iterator pit = partition_map.find(id);
         if (pit != partition_map.end()) {
             return &partitions[pit->second];
@@ -291,6 +314,9 @@ void partitioning_target_equationt::fill_stub_partition(partition_idt partition_
     partitiont & partition = partitions.at(partition_id);
     assert(partition.has_no_representation());
     partition.add_stub_representation();
+    if (streaming) {
+        partition_finished(partition_id);
+    }
 }
 
 void partitioning_target_equationt::select_partition(partition_idt partition_id) {
@@ -302,28 +328,268 @@ void partitioning_target_equationt::select_partition(partition_idt partition_id)
     if(new_partition.has_ssa_representation()){
         throw std::logic_error("About to process partition that has been processed already!");
     }
-    new_partition.start_idx = SSA_steps.size();
+    new_partition.start_idx = SSA_step_arena.size();
 }
 
 
 
+/*******************************************************************
+ Function: partitioning_target_equationt::release_converted_steps
+
+ Purpose: Frees the expressions of the SSA steps whose partition is in the
+ solver already (low-memory mode). Conversion, slicing and error traces
+ cannot be done on such steps anymore. The convertor's cache would keep
+ the expressions alive, so it keeps only the nodes still reachable from
+ the remaining steps and from the interfaces of the partitions.
+ \*******************************************************************/
+std::size_t partitioning_target_equationt::release_converted_steps(convertort & convertor) {
+    assert(low_memory);
+    std::size_t released = 0;
+    for (auto & partition : partitions) {
+        if (!partition.converted || !partition.has_ssa_representation()) { continue; }
+        for (auto & step : get_partition_steps(partition)) {
+            if (step.guard.is_nil()) { continue; } // released before
+            step.guard.make_nil();
+            step.ssa_lhs.make_nil();
+            step.ssa_full_lhs.make_nil();
+            step.original_full_lhs.make_nil();
+            step.ssa_rhs.make_nil();
+            step.cond_expr.make_nil();
+            step.io_args.clear();
+            step.converted_io_args.clear();
+            step.ssa_function_arguments.clear();
+            step.converted_function_arguments.clear();
+            ++released;
+        }
+    }
+
+    std::unordered_set<const irept::dt *> used;
+    std::vector<const irept *> to_visit;
+    auto use = [&used, &to_visit](const irept & irep) {
+        if (used.insert(&irep.read()).second) { to_visit.push_back(&irep); }
+    };
+    auto use_step = [&use](const SSA_stept & step) {
+        if (step.guard.is_nil()) { return; }
+        use(step.guard);
+        use(step.ssa_lhs);
+        use(step.ssa_full_lhs);
+        use(step.original_full_lhs);
+        use(step.ssa_rhs);
+        use(step.cond_expr);
+        for (const auto & arg : step.io_args) { use(arg); }
+        for (const auto & arg : step.ssa_function_arguments) { use(arg); }
+    };
+    for (const auto & step : SSA_step_arena.range(0, SSA_step_arena.size())) { use_step(step); }
+    for (const auto & step : SSA_steps) { use_step(step); }
+    for (const auto & partition : partitions) {
+        const partition_ifacet & iface = partition.get_iface();
+        for (const auto & symbol : iface.argument_symbols) { use(symbol); }
+        for (const auto & symbol : iface.out_arg_symbols) { use(symbol); }
+        for (const auto & value : iface.argument_values) { use(value); }
+        use(iface.retval_symbol);
+        use(iface.callstart_symbol);
+        use(iface.callend_symbol);
+        use(iface.error_symbol);
+    }
+    while (!to_visit.empty()) {
+        const irept & irep = *to_visit.back();
+        to_visit.pop_back();
+        for (const auto & sub : irep.get_sub()) { use(sub); }
+        for (const auto & named : irep.get_named_sub()) { use(named.second); }
+    }
+    convertor.retain_expressions(used);
+    return released;
+}
+
 unsigned partitioning_target_equationt::count_partition_assertions(const partitiont & partition) const {
     unsigned i = 0;
-    for (SSA_stepst::const_iterator
-           it = partition.start_it;
-         it != partition.end_it; it++)
-        if (it->is_assert()) i++;
+    for (const auto & step : SSA_step_arena.range(partition.start_idx, partition.end_idx))
+        if (step.is_assert()) i++;
     return i;
 }
 
+std::size_t partitioning_target_equationt::count_assertions() const {
+    return std::count_if(SSA_step_arena.begin(), SSA_step_arena.end(),
+                         [](const SSA_stept & step) { return step.is_assert(); });
+}
+
+std::size_t partitioning_target_equationt::count_ignored_SSA_steps() const {
+    return std::count_if(SSA_step_arena.begin(), SSA_step_arena.end(),
+                         [](const SSA_stept & step) { return step.ignore; });
+}
+
 void partitioning_target_equationt::close_current_partition()  {
+    {
+        // steps generated for the current partition are moved to the arena
+        std::lock_guard<std::mutex> lock{structure_mutex};
+        store_SSA_steps();
+    }
     if (current_partition_id != NO_PARTITION_ID) {
+        const partition_idt partition_id = current_partition_id;
         auto & partition = get_current_partition();
-        partition.end_idx = SSA_steps.size();
+        partition.end_idx = SSA_step_arena.size();
         assert(!partition.has_ssa_representation());
         partition.add_ssa_representation();
         current_partition_id = NO_PARTITION_ID;
+        if (streaming) {
+            compute_partition_ignore(partition);
+            partition_finished(partition_id);
+        }
+    }
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::partition_finished
+
+ Purpose: Called by symex when the given partition got its final
+ representation. The partitions are handed to the converter in the
+ post-order of the partition tree: a partition follows its children
+ (in the order of their ids), the next one waits for any unfinished
+ partition before it in that order.
+ \*******************************************************************/
+void partitioning_target_equationt::partition_finished(partition_idt partition_id) {
+    // children are always reserved before their parent is finished
+    finished_partitions.resize(partitions.size(), false);
+    queued_partitions.resize(partitions.size(), false);
+    finished_partitions[partition_id] = true;
+
+    // only finished partitions enter the path, their children are known
+    while (true) {
+        if (stream_path.empty()) {
+            if (stream_roots.empty() || !finished_partitions[stream_roots.front()]) { return; }
+            const partition_idt root_id = stream_roots.front();
+            stream_roots.pop_front();
+            stream_path.emplace_back(root_id, partitions[root_id].child_ids.cbegin());
+            continue;
+        }
+        auto & next = stream_path.back();
+        if (next.second != partitions[next.first].child_ids.cend()) {
+            const partition_idt child_id = *next.second;
+            if (!finished_partitions[child_id]) { return; }
+            ++next.second;
+            stream_path.emplace_back(child_id, partitions[child_id].child_ids.cbegin());
+            continue;
+        }
+        const partition_idt queued_id = next.first;
+        stream_path.pop_back();
+        queued_partitions[queued_id] = true;
+        ++streamed_count;
+        {
+            std::lock_guard<std::mutex> lock{queue_mutex};
+            conversion_queue.push_back(queued_id);
+        }
+        queue_cv.notify_one();
+    }
+}
+
+partitiont & partitioning_target_equationt::lookup_partition(partition_idt partition_id) {
+    std::lock_guard<std::mutex> lock{structure_mutex};
+    return partitions[partition_id];
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::start_streaming_conversion
+
+ Purpose: Starts the thread converting the partitions handed over
+ by partition_finished. A handed over partition is final: symex does not
+ change its steps, interface or call tree node any more. The converter
+ reads the summary store too, so the store is read only until the thread
+ stops. The converter does not read the symbols symex adds (those are in
+ the symbol table of the symex state, not in the one of the namespace).
+ \*******************************************************************/
+void partitioning_target_equationt::start_streaming_conversion(
+        convertort &convertor, interpolating_solvert &interpolator)
+{
+    assert(!streaming && !converter_thread.joinable());
+    streaming = true;
+    symex_done = false;
+    converter_error = nullptr;
+    conversion_queue.clear();
+    // partitions existing already are converted by finish_streaming_conversion
+    finished_partitions.assign(partitions.size(), false);
+    queued_partitions.assign(partitions.size(), false);
+    streamed_count = 0;
+    stream_roots.clear();
+    stream_path.clear();
+    for (std::size_t id = 0; id < partitions.size(); ++id) {
+        if (!partitions[id].has_parent()) {
+            stream_roots.push_back(id);
+        }
+    }
+    // the converter reads the summaries of the summarized partitions
+    summary_store.set_read_only(true);
+    converter_thread = std::thread{[this, &convertor, &interpolator]() {
+        run_converter(convertor, interpolator);
+    }};
+}
+
+void partitioning_target_equationt::run_converter(
+        convertort &convertor, interpolating_solvert &interpolator)
+{
+    while (true) {
+        partition_idt partition_id;
+        {
+            std::unique_lock<std::mutex> lock{queue_mutex};
+            queue_cv.wait(lock, [this]() { return symex_done || !conversion_queue.empty(); });
+            if (conversion_queue.empty()) { return; }
+            partition_id = conversion_queue.front();
+            conversion_queue.pop_front();
+        }
+        try {
+            // symex keeps going, the steps and the partition stay in place
+            convert_partition(convertor, interpolator, lookup_partition(partition_id));
+        }
+        catch (...) {
+            // rethrown by finish_streaming_conversion
+            converter_error = std::current_exception();
+            return;
+        }
+    }
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::finish_streaming_conversion
+
+ Purpose: Waits until the conversion thread converts everything it got,
+ then converts the remaining partitions (children before parents, as
+ convert does).
+ \*******************************************************************/
+std::size_t partitioning_target_equationt::finish_streaming_conversion(
+        convertort &convertor, interpolating_solvert &interpolator)
+{
+    assert(streaming);
+    {
+        std::lock_guard<std::mutex> lock{queue_mutex};
+        symex_done = true;
     }
+    queue_cv.notify_all();
+    converter_thread.join();
+    streaming = false;
+    summary_store.set_read_only(false);
+    if (converter_error) {
+        std::rethrow_exception(converter_error);
+    }
+
+    for (auto id = partitions.size(); id-- > 0;) {
+        if (id >= queued_partitions.size() || !queued_partitions[id]) {
+            convert_partition(convertor, interpolator, partitions[id]);
+        }
+    }
+    return streamed_count;
+}
+
+// Stops the conversion thread without converting the rest, e.g., when symex failed
+void partitioning_target_equationt::stop_converter() {
+    if (!converter_thread.joinable()) { return; }
+    {
+        std::lock_guard<std::mutex> lock{queue_mutex};
+        symex_done = true;
+        conversion_queue.clear();
+    }
+    queue_cv.notify_all();
+    converter_thread.join();
+    streaming = false;
+    summary_store.set_read_only(false);
 }
 
 /***************************************************************************/
@@ -420,14 +686,22 @@ void partitioning_target_equationt::convert_partition_assertions(
 
     auto assumption_literal = convertor.get_const_literal(true); //boundaries for LA
     auto var_constraints_lit = convertor.get_and_clear_var_constraints();
-    for (symex_target_equationt::SSA_stepst::iterator it = partition.start_it; it != partition.end_it; ++it) {
+    auto const partition_steps = get_partition_steps(partition);
+    for (auto it = partition_steps.begin(); it != partition_steps.end(); ++it) {
         if(it->ignore) {continue;} // ignored instructions can be skippied
         if (it->is_assert()) {
 
             // Collect ass \in assertions(f) in bv
             auto tmp_literal = convertor.land(convertor.convert_bool_expr(it->cond_expr), var_constraints_lit);
             it->cond_literal = flaref_to_literal(convertor.limplies(assumption_literal, tmp_literal));
-            error_lits.push_back(!literal_to_flaref(it->cond_literal)); // negated literal
+            if (claim_selection) {
+                // only the selected claims can contribute to the error
+                error_lits.push_back(convertor.land(get_claim_selector(convertor, it->source.pc),
+                                                    !literal_to_flaref(it->cond_literal)));
+                selected_assertions.emplace_back(it->source.pc, it->cond_literal);
+            } else {
+                error_lits.push_back(!literal_to_flaref(it->cond_literal)); // negated literal
+            }
 //          Commented since CProver5.12: Instead of converting to Literalt, use CProver methods operating on exprt to exprt
 //            it->cond_handle = implies_exprt(assumption_expr, it->cond_expr);
 ////          error_lits.push_back(!literal_to_flaref(it->cond_literal)); // negated literal
@@ -459,7 +733,7 @@ void partitioning_target_equationt::convert_partition_assertions(
                         target_partition_iface.callstart_symbol, partition_smt_decl, false);
 
                     std::stringstream out_temp;
-                    for (auto it2 = partition.start_it; it2 != it; ++it2) {
+                    for (auto it2 = partition_steps.begin(); it2 != it; ++it2) {
                         if (it2->is_assume() && !it2->ignore) {
                             assume_counter++;
                             expr_ssa_print(out_temp << "        ", it2->cond_expr, partition_smt_decl, false);
@@ -490,7 +764,7 @@ void partitioning_target_equationt::convert_partition_assertions(
     }
 
     for (auto const & child_id : partition.child_ids) {
-        const partitiont& target_partition = partitions[child_id];
+        const partitiont& target_partition = lookup_partition(child_id);
         if (target_partition.get_iface().assertion_in_subtree) {
             // Collect error_g, where g \in children(f) in bv
             error_lits.push_back(target_partition.get_iface().error_literal);
@@ -534,7 +808,7 @@ void partitioning_target_equationt::convert_partition_assertions(
                         partition_smt_decl, false, true);
         std::stringstream out_temp; // Pre-order printing
         int assume_counter = 0;
-        for (auto it2 = partition.start_it; it2 != partition.end_it; ++it2) {
+        for (auto it2 = partition_steps.begin(); it2 != partition_steps.end(); ++it2) {
             if (it2->is_assume() && !it2->ignore) {
                 if (assume_counter == 0 && isFirstCallExpr(it2->cond_expr)) {
                     assume_counter++;
@@ -554,6 +828,66 @@ void partitioning_target_equationt::convert_partition_assertions(
 //    }
 }
 
+/*******************************************************************
+ Function: partitioning_target_equationt::get_claim_selector
+
+ Purpose: The literal enabling the given claim; all assertions of the
+ same claim (e.g., in different calling contexts) share it
+
+ \*******************************************************************/
+
+FlaRef partitioning_target_equationt::get_claim_selector(
+        convertort &convertor, goto_programt::const_targett claim)
+{
+    auto it = claim_selectors.find(claim);
+    if (it == claim_selectors.end()) {
+        symbol_exprt selector{HifrogStringConstants::CLAIM_SELECTOR + std::to_string(claim->location_number),
+                              bool_typet()};
+        it = claim_selectors.emplace(claim, convertor.convert_bool_expr(selector)).first;
+    }
+    return it->second;
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::get_violated_claims
+
+ Purpose: The enabled claims with an assertion that fails in the
+ current model
+
+ \*******************************************************************/
+
+std::vector<goto_programt::const_targett> partitioning_target_equationt::get_violated_claims(
+        const solvert & solver) const
+{
+    std::set<goto_programt::const_targett> violated;
+    for (const auto & assertion : selected_assertions) {
+        if (disabled_claims.count(assertion.first) == 0 &&
+            !solver.is_assignment_true(literal_to_flaref(assertion.second))) {
+            violated.insert(assertion.first);
+        }
+    }
+    return {violated.begin(), violated.end()};
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::disable_claim
+
+ Purpose: Asserts the negation of the selector of the claim, in a new
+ partition so that it gets to the solver with the next check
+
+ \*******************************************************************/
+
+void partitioning_target_equationt::disable_claim(convertort &convertor,
+        interpolating_solvert &interpolator, goto_programt::const_targett claim)
+{
+    const auto it = claim_selectors.find(claim);
+    if (it == claim_selectors.end() || !disabled_claims.insert(claim).second) {
+        return;
+    }
+    interpolator.new_partition();
+    convertor.assert_literal(!it->second);
+}
+
 /*******************************************************************
  Function: partitioning_target_equationt::convert_partition_assumptions
 
@@ -563,11 +897,11 @@ void partitioning_target_equationt::convert_partition_assertions(
 
 void partitioning_target_equationt::convert_partition_assumptions(
         convertort &convertor, partitiont &partition) {
-    for (symex_target_equationt::SSA_stepst::iterator it = partition.start_it; it != partition.end_it; ++it) {
-        if (it->is_assume()) {
+    for (auto & step : get_partition_steps(partition)) {
+        if (step.is_assume()) {
             //it->cond_literal = flaref_to_literal(it->ignore ? const_formula(true) : convertor.convert_bool_expr(it->cond_expr));
             //it->cond_handle = it->ignore ? true_exprt() : (it->cond_expr);
-            it->cond_literal = flaref_to_literal(it->ignore ? const_formula(true) : convertor.convert_bool_expr(it->cond_expr));
+            step.cond_literal = flaref_to_literal(step.ignore ? const_formula(true) : convertor.convert_bool_expr(step.cond_expr));
         }
     }
 }
@@ -585,7 +919,8 @@ void partitioning_target_equationt::convert_partition_assumptions(
 
 void partitioning_target_equationt::convert_partition_io(
         convertort &convertor, partitiont &partition) {
-    for (SSA_stepst::iterator it = partition.start_it; it != partition.end_it; ++it) {
+    auto const partition_steps = get_partition_steps(partition);
+    for (auto it = partition_steps.begin(); it != partition_steps.end(); ++it) {
         if (!it->ignore) {
             for (std::list<exprt>::const_iterator o_it = it->io_args.begin(); o_it
                                                                               != it->io_args.end(); ++o_it) {
@@ -636,8 +971,8 @@ void partitioning_target_equationt::convert_partition_summary(
         auto &summary = summary_store.find_summary(summary_id);
         if ((!is_recursive)) {
             // we do not want to actually change the summary, because we might need the template later,
-            // we just get a PTRef to the substituted version
-            interpolator.insert_substituted(summary, common_symbs);
+            // we just get a PTRef to the substituted version (specialized to the constant actuals)
+            interpolator.insert_specialized(summary, common_symbs, partition.get_iface().argument_values);
         }
     }
     
@@ -656,6 +991,7 @@ ll
 void partitioning_target_equationt::convert_partition(
         convertort &convertor, interpolating_solvert &interpolator,
         partitiont &partition) {
+    partition.converted = true;
     if (partition.ignore) {
         return;
     }
@@ -728,7 +1064,12 @@ void partitioning_target_equationt::convert(convertort &convertor,
 #ifdef DISABLE_OPTIMIZATIONS
     getFirstCallExpr(); // Save the first call to the first function
 #endif
+    // the released steps (low-memory mode) cannot be analyzed anymore
+    if (convertor.can_restrict_type_constraints() && !low_memory) {
+        convertor.set_bounded_symbols(collect_bounded_symbols());
+    }
     for (auto it = partitions.rbegin(); it != partitions.rend(); ++it) {
+        if (low_memory && it->converted) { continue; }
         convert_partition(convertor, interpolator, *it);
 #   ifdef DISABLE_OPTIMIZATIONS
         if (it->get_fle_part_ids().empty()) { continue;} // NO conversion happend
@@ -756,6 +1097,111 @@ void partitioning_target_equationt::convert(convertort &convertor,
       }
 #endif
 }
+namespace {
+bool is_arithmetic(const exprt & expr) {
+    const irep_idt & id = expr.id();
+    return id == ID_plus || id == ID_minus || id == ID_mult || id == ID_div || id == ID_mod ||
+           id == ID_unary_minus || id == ID_shl || id == ID_ashr || id == ID_lshr;
+}
+
+bool is_inequality(const exprt & expr) {
+    const irep_idt & id = expr.id();
+    return id == ID_lt || id == ID_le || id == ID_gt || id == ID_ge;
+}
+
+const exprt & skip_typecasts(const exprt & expr) {
+    return expr.id() == ID_typecast ? skip_typecasts(to_typecast_expr(expr).op()) : expr;
+}
+
+// Symbols the value of the expression is copied from (through casts and branches)
+void value_symbols(const exprt & expr, std::vector<irep_idt> & symbols) {
+    const exprt & value = skip_typecasts(expr);
+    if (value.id() == ID_if) {
+        value_symbols(to_if_expr(value).true_case(), symbols);
+        value_symbols(to_if_expr(value).false_case(), symbols);
+    } else if (value.id() == ID_symbol || value.id() == ID_nondet_symbol) {
+        symbols.push_back(value.get(ID_identifier));
+    }
+}
+
+// A side of an equality whose value may be out of the range of the other side:
+// the result of arithmetic (it could overflow), a constant or a cast (of another width)
+bool may_leave_range(const exprt & expr) {
+    return expr.id() == ID_typecast || expr.id() == ID_constant || is_arithmetic(expr);
+}
+
+// Symbols in the positions of the expression where their range matters
+void range_sensitive_symbols(const exprt & expr, std::vector<irep_idt> & symbols) {
+    for (auto it = expr.depth_cbegin(); it != expr.depth_cend(); ++it) {
+        if (is_arithmetic(*it) || is_inequality(*it)) {
+            for (const auto & operand : it->operands()) {
+                value_symbols(operand, symbols);
+            }
+        } else if ((it->id() == ID_equal || it->id() == ID_notequal) && it->operands().size() == 2) {
+            if (may_leave_range(it->op0()) || may_leave_range(it->op1())) {
+                value_symbols(it->op0(), symbols);
+                value_symbols(it->op1(), symbols);
+            }
+        }
+    }
+}
+}
+
+/*******************************************************************
+ Function: partitioning_target_equationt::collect_bounded_symbols
+
+ Purpose: Collects the symbols whose range matters: the operands of
+ arithmetic and of inequalities, the operands of equalities with a cast,
+ a constant or arithmetic on one side, the results of arithmetic, the
+ interfaces of partitions without SSA (their summaries are not analyzed)
+ and, backwards through copies, whatever those symbols are copied from.
+ Other symbols are only copied or compared for equality with symbols of
+ their own type, so any model can be changed to keep them in the range
+ of their type. This holds only if the type constraints are assumed;
+ asserted ones (type constraints level 2) are a part of the error
+ condition, so nothing can be dropped.
+\*******************************************************************/
+std::unordered_set<irep_idt> partitioning_target_equationt::collect_bounded_symbols() {
+    std::unordered_set<irep_idt> bounded;
+    std::unordered_map<irep_idt, std::vector<irep_idt>> copied_from;
+    std::vector<irep_idt> seeds;
+
+    for (const auto & partition : partitions) {
+        if (partition.ignore) { continue; }
+        if (!partition.has_ssa_representation() || partition.has_abstract_representation()) {
+            for (const auto & symbol : partition.get_iface().get_iface_symbols()) {
+                seeds.push_back(symbol.get_identifier());
+            }
+        }
+        if (!partition.has_ssa_representation()) { continue; }
+        for (const auto & step : get_partition_steps(partition)) {
+            if (step.ignore) { continue; }
+            range_sensitive_symbols(step.guard, seeds);
+            if (step.is_assignment()) {
+                const irep_idt & lhs = step.ssa_lhs.get_identifier();
+                if (is_arithmetic(skip_typecasts(step.ssa_rhs))) {
+                    seeds.push_back(lhs);
+                }
+                value_symbols(step.ssa_rhs, copied_from[lhs]);
+                range_sensitive_symbols(step.ssa_rhs, seeds);
+            } else if (step.is_assume() || step.is_assert()) {
+                range_sensitive_symbols(step.cond_expr, seeds);
+            }
+        }
+    }
+
+    while (!seeds.empty()) {
+        irep_idt symbol = seeds.back();
+        seeds.pop_back();
+        if (!bounded.insert(symbol).second) { continue; }
+        auto it = copied_from.find(symbol);
+        if (it != copied_from.end()) {
+            seeds.insert(seeds.end(), it->second.begin(), it->second.end());
+        }
+    }
+    return bounded;
+}
+
 /*******************************************************************
  Function: partitioning_target_equationt::extract_interpolants()
 
@@ -867,6 +1313,9 @@ void partitioning_target_equationt::extract_interpolants(interpolating_solvert &
         // Store the interpolant in summary_storet and asks a new ID for each summary
         auto new_id = summary_store.insert_summary(itp, id2string(partition.get_iface().function_id));
         partition.get_iface().call_tree_node.add_node_sumID(new_id);
+        summary_store.register_summary_context(new_id, id2string(partition.get_iface().function_id),
+                                               partition.get_iface().call_tree_node.get_call_site_signature(),
+                                               partition.get_iface().call_tree_node.get_calling_context_hash());
         //for stat
         summary_store.generated_sumIDs.insert(new_id);
         // Update the precision information for omega deserialization; which partition
@@ -892,9 +1341,8 @@ std::vector<exprt> partitioning_target_equationt::get_exprs_to_refine() {
     for (auto const & partition : partitions) {
         if (partition.ignore || partition.has_abstract_representation()) {continue;}
         assert(partition.is_real_ssa_partition());
-        auto partition_beg = partition.start_it;
-        auto partition_end = partition.end_it;
-        for (auto it = partition_beg; it != partition_end; ++it) {
+        auto const partition_steps = get_partition_steps(partition);
+        for (auto it = partition_steps.begin(); it != partition_steps.end(); ++it) {
             if (it->ignore) { continue; }
             if (it->is_assignment()) {
                 res.push_back(it->cond_expr);
@@ -924,9 +1372,10 @@ std::vector<exprt> partitioning_target_equationt::get_exprs_to_refine() {
 }
 
 void partitioning_target_equationt::convert_partition_guards(convertort &convertor, partitiont &partition) {
-    ::convert_guards(convertor, partition.start_it, partition.end_it);
+    auto const partition_steps = get_partition_steps(partition);
+    ::convert_guards(convertor, partition_steps.begin(), partition_steps.end());
 #ifdef DISABLE_OPTIMIZATIONS
-    for(auto it = partition.start_it; it != partition.end_it; ++it) {
+    for(auto it = partition_steps.begin(); it != partition_steps.end(); ++it) {
         if (it->ignore) { continue; }
         expr_ssa_print_guard(out_terms, it->guard, partition_smt_decl);
         if (!it->guard.is_boolean())
@@ -937,9 +1386,10 @@ void partitioning_target_equationt::convert_partition_guards(convertort &convert
 }
 
 void partitioning_target_equationt::convert_partition_assignments(convertort &convertor, partitiont &partition) {
-    ::convert_assignments(convertor, partition.start_it, partition.end_it);
+    auto const partition_steps = get_partition_steps(partition);
+    ::convert_assignments(convertor, partition_steps.begin(), partition_steps.end());
 #ifdef DISABLE_OPTIMIZATIONS
-    for(auto it = partition.start_it; it != partition.end_it; ++it) {
+    for(auto it = partition_steps.begin(); it != partition_steps.end(); ++it) {
         if(it->is_assignment() && !it->ignore){
             expr_ssa_print(out_terms << "    ", it->cond_expr, partition_smt_decl, false);
             terms_counter++;
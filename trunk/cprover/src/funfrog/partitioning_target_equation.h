@@ -25,11 +25,24 @@ different deferred functions.
 #include "solvers/interpolating_solver_fwd.h"
 #include "partition.h"
 #include "call_tree_node.h"
+#include "ssa_step_arena.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_set>
 
 class partition_ifacet;
 class interpolating_solvert;
+class solvert;
 
 typedef std::vector<symex_target_equationt::SSA_stept*> SSA_steps_orderingt;
+// Indices into the SSA step arena, ordered by program execution
+typedef std::vector<std::size_t> SSA_steps_permutationt;
 
 class partitioning_target_equationt:public symex_target_equationt
 {
@@ -39,6 +52,7 @@ public:
 
   // First this called and then the parent d'tor due to the use of virtual
   virtual ~partitioning_target_equationt() {
+    stop_converter();
 #         ifdef DISABLE_OPTIMIZATIONS        
 	  partition_smt_decl->clear();
 	  delete partition_smt_decl;        
@@ -72,17 +86,32 @@ public:
   // processing and conversion
   void prepare_partitions();
 
+  // Returns indices of SSA steps (into the step arena) ordered in the order of
+  // program execution (i.e., as they would be normally ordered in symex_target_equation).
+  const SSA_steps_permutationt& get_steps_exec_permutation() {
+    if (exec_order_steps_count != SSA_step_arena.size()) {
+      // Prepare SSA ordering according to the program execution order.
+      assert(!partitions.empty());
+      SSA_steps_exec_permutation.clear();
+      SSA_steps_exec_permutation.reserve(SSA_step_arena.size());
+      prepare_SSA_exec_order(partitions[0]);
+      //NOTE: the permutation does not cover steps of partitions that were summarized
+      exec_order_steps_count = SSA_step_arena.size();
+      SSA_steps_exec_order.clear();
+    }
+    return SSA_steps_exec_permutation;
+  }
+
   // Returns SSA steps ordered in the order of program execution (i.e., as they
   // would be normally ordered in symex_target_equation). //it is needed for building error trace
   const SSA_steps_orderingt& get_steps_exec_order() {
-    if (SSA_steps_exec_order.size() != SSA_steps.size()) {
-      // Prepare SSA ordering according to the program execution order.
-      assert(!partitions.empty());
+    const auto & permutation = get_steps_exec_permutation();
+    if (SSA_steps_exec_order.size() != permutation.size()) {
       SSA_steps_exec_order.clear();
-      SSA_steps_exec_order.reserve(SSA_steps.size());
-      prepare_SSA_exec_order(partitions[0]);
-      //FIXME: assertion simply doesn't hold if there were some summaries substituted
-      //assert(SSA_steps_exec_order.size() == SSA_steps.size());
+      SSA_steps_exec_order.reserve(permutation.size());
+      for (auto idx : permutation) {
+        SSA_steps_exec_order.push_back(&SSA_step_arena[idx]);
+      }
     }
     return SSA_steps_exec_order;
   }
@@ -91,12 +120,62 @@ public:
 
   void convert(convertort &prop_conv, interpolating_solvert &interpolator);
 
+  // Symbols whose range can matter for the type constraints of the LA encodings
+  std::unordered_set<irep_idt> collect_bounded_symbols();
+
+  // Starts converting partitions on a separate thread while symex is still
+  // generating the others. The partitions are handed over in the post-order
+  // of the partition tree (children in the order of their ids), so the
+  // children are still converted first and the order does not depend on
+  // the order in which symex finishes them.
+  // The convertor must not be used by anyone else until the conversion is finished.
+  // NOTE: the SSA steps must not change after their partition is closed (no slicing).
+  void start_streaming_conversion(convertort &convertor, interpolating_solvert &interpolator);
+
+  // Waits for the conversion thread and converts the partitions it has not
+  // got (if any); afterwards the equation is converted as by convert().
+  // Returns the number of partitions converted during symex.
+  std::size_t finish_streaming_conversion(convertort &convertor, interpolating_solvert &interpolator);
+
   partitionst& get_partitions() { return partitions; }
 
-  unsigned get_SSA_steps_count() const { return SSA_steps.size(); }
+  // In the low-memory mode, convert() skips the partitions whose current
+  // representation is in the solver already, so that their steps can be released
+  void set_low_memory(bool _low_memory) { low_memory = _low_memory; }
+
+  // Drops the expressions of the SSA steps of the converted partitions; only
+  // the flags and literals stay. The convertor forgets their conversions too.
+  // Returns the number of released steps.
+  std::size_t release_converted_steps(convertort & convertor);
+
+  // Steps already moved to the arena plus the steps of the partition being currently generated
+  unsigned get_SSA_steps_count() const { return SSA_step_arena.size() + SSA_steps.size(); }
+
+  // NOTE: hides the versions of symex_target_equationt, which only see the not yet stored steps
+  std::size_t count_assertions() const;
+  std::size_t count_ignored_SSA_steps() const;
+
+  ssa_step_arenat & get_SSA_steps() { return SSA_step_arena; }
+  const ssa_step_arenat & get_SSA_steps() const { return SSA_step_arena; }
+
+  // SSA steps corresponding to the given partition
+  ssa_step_arenat::ranget<ssa_step_arenat::iterator> get_partition_steps(const partitiont & partition) {
+    return SSA_step_arena.range(partition.start_idx, partition.end_idx);
+  }
 
   std::vector<exprt> get_exprs_to_refine();
 
+  // With claim selection, each assertion is guarded by a selector literal, so
+  // the claims of one equation can be checked (and discharged) one by one
+  void set_claim_selection(bool _claim_selection) { claim_selection = _claim_selection; }
+
+  // Enabled claims whose assertion is false in the current model of the solver
+  std::vector<goto_programt::const_targett> get_violated_claims(const solvert & solver) const;
+
+  // Turns the claim off in the solver for the following checks (cannot be undone)
+  void disable_claim(convertort &convertor, interpolating_solvert &interpolator,
+                     goto_programt::const_targett claim);
+
   const summary_storet & get_summary_store() const { return summary_store; }
 
   void fill_function_templates(interpolating_solvert &interpolator, std::vector<itpt_summaryt*>& templates);
@@ -171,11 +250,15 @@ protected:
   // Fill in ids of all the child partitions
   void fill_partition_ids(partition_idt partition_id, fle_part_idst& part_ids);
 
-  // Fills in the SSA_steps_exec_order holding pointers to SSA steps ordered
+  // Fills in the SSA_steps_exec_permutation holding indices of SSA steps ordered
   // in the order of program execution (i.e., as they would be normally
   // ordered in symex_target_equation).
   void prepare_SSA_exec_order(const partitiont& partition);
 
+  // Moves the SSA steps generated by symex (the base class appends them to
+  // SSA_steps) to the step arena.
+  void store_SSA_steps();
+
   // Find partition corresponding to the function call.
   // If the given SSA step is a callend assumption, the corresponding target
   // partition is returned. If not, NULL is returned.
@@ -189,11 +272,31 @@ protected:
 
     void close_current_partition();
 
+  // Sets the ignore flag of the partition from the flags of its steps
+  void compute_partition_ignore(partitiont & partition);
+
+  // Marks the partition finished and hands the partitions it unblocks in
+  // the post-order of the partition tree to the conversion thread
+  void partition_finished(partition_idt partition_id);
+
+  // The partition with the given id, safe to call from the conversion
+  // thread; the reference stays valid while symex adds partitions
+  partitiont & lookup_partition(partition_idt partition_id);
+
+  void run_converter(convertort &convertor, interpolating_solvert &interpolator);
+
+  void stop_converter();
+
 
   summary_storet & summary_store;
   // Collection of all the partitions
   partitionst partitions;
 
+  // Storage of all the SSA steps; partitions refer to it by index ranges.
+  // SSA_steps of the base class only holds the steps of the partition
+  // being currently generated.
+  ssa_step_arenat SSA_step_arena;
+
   // Mapping between callend symbol and the corresponding partition
   // This is used to emit assumption propagation constraints.
   partition_mapt partition_map;
@@ -202,12 +305,49 @@ protected:
   // filled in by prepare_SSA_exec_order and can be used for simple slicing
   // and error trace generation.
   // NOTE: Currently, the order is slightly broken by the glue variables
+  SSA_steps_permutationt SSA_steps_exec_permutation;
+  // Number of steps in the arena when the permutation was computed
+  std::size_t exec_order_steps_count {0};
+  // Pointers to the steps of the permutation (for clients working with steps directly)
   SSA_steps_orderingt SSA_steps_exec_order;
 
   // Should we store summaries with assertion in subtree?
   // This is used in upgrade checking.
   bool store_summaries_with_assertion;
 
+  bool low_memory {false};
+
+  bool claim_selection {false};
+  std::map<goto_programt::const_targett, FlaRef> claim_selectors;
+  std::set<goto_programt::const_targett> disabled_claims;
+  // Claim and literal of each converted assertion
+  std::vector<std::pair<goto_programt::const_targett, literalt>> selected_assertions;
+
+  FlaRef get_claim_selector(convertort &convertor, goto_programt::const_targett claim);
+
+  // Streaming conversion (see start_streaming_conversion).
+  // structure_mutex guards the growth of partitions and partition_map; the
+  // converter takes it only to look a partition up, symex only to add one.
+  // The steps of a handed over partition are read without it (see ssa_step_arenat).
+  // The summary store is read only while the converter runs.
+  bool streaming {false};
+  std::thread converter_thread;
+  std::mutex structure_mutex;
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  std::deque<partition_idt> conversion_queue;
+  bool symex_done {false};
+  std::exception_ptr converter_error;
+  // Bookkeeping of symex (not touched by the converter)
+  std::vector<bool> finished_partitions;
+  std::vector<bool> queued_partitions;
+  std::size_t streamed_count {0};
+  // Post-order traversal of the partition tree: the roots not visited yet
+  // and the path to the next partition to hand over, with the next child
+  // to visit of each partition on it
+  std::deque<partition_idt> stream_roots;
+  std::vector<std::pair<partition_idt, partition_idst::const_iterator>> stream_path;
+
   friend class partitioning_slicet;
 };
 
@@ -31,15 +31,15 @@ void refiner_assertion_sumt::reset_inline(call_tree_nodet& node)
   for (call_sitest::iterator it = node.get_call_sites().begin();
           it != node.get_call_sites().end(); ++it)
   {
-    if ((it->second).get_precision() != INLINE){
-      set_inline_sum(it->second);
-      if ((it->second).is_recursion_nondet()){
-          status() << "Automatically increasing unwinding bound for " << (it->second).get_function_id() << eom;
-          omega.refine_recursion_call(it->second);
+    if ((it->second)->get_precision() != INLINE){
+      set_inline_sum(*it->second);
+      if ((it->second)->is_recursion_nondet()){
+          status() << "Automatically increasing unwinding bound for " << (it->second)->get_function_id() << eom;
+          omega.refine_recursion_call(*it->second);
       }
     }
     else {
-      reset_inline(it->second);
+      reset_inline(*it->second);
     }
   }
 }
@@ -50,16 +50,16 @@ void refiner_assertion_sumt::reset_random(call_tree_nodet& node)
     for (call_sitest::iterator it = node.get_call_sites().begin();
             it != node.get_call_sites().end(); ++it)
     {
-      summary_precisiont precision = (it->second).get_precision();
+      summary_precisiont precision = (it->second)->get_precision();
       if ((precision == SUMMARY) ||    // if there were some summaries,
                                        // try to inline them first
           (precision == HAVOC && summs_size == 0)){  // and if there were not
                                                      // then refine havoced calls
         if (rand() % 1000 < 300 || rand() % 1000 > 800){
-          set_inline_sum(it->second);
+          set_inline_sum(*it->second);
         }
       }
-      reset_random(it->second);
+      reset_random(*it->second);
                                        // TODO: we can actually try do it vice-versa
     }                                  // but due to more sophisticated choice of nondets in s_info init
                                        // there are more chances that the reason of SAT was in 2weak summaries
@@ -20,6 +20,25 @@ void smt_summary_storet::serialize(std::ostream &out) const {
 }
 
 
+#ifdef PRODUCE_PROOF
+/*******************************************************************\
+ Function: smt_summary_storet::abstract_non_linears
+
+ Purpose: rewrites the bodies of the summaries on the terms of the
+ decider, before they are serialized for a decider of another theory
+\*******************************************************************/
+std::size_t smt_summary_storet::abstract_non_linears() {
+    std::unordered_map<PTRef, PTRef, PTRefHash> abstraction;
+    for (auto & summary_node : store){
+        auto & summary = static_cast<smt_itpt_summaryt &>(*summary_node.summary);
+        PTRef body = decider->abstract_non_linears(summary.getTempl().getBody(), abstraction);
+        summary.getTempl().setBody(body);
+        summary.setInterpolant(body);
+    }
+    return abstraction.size();
+}
+#endif // PRODUCE_PROOF
+
 // SMT logics deser
 void smt_summary_storet::deserialize(std::vector<std::string> fileNames) {
 
@@ -26,6 +26,12 @@ public:
   virtual void deserialize(std::vector<std::string> fileNames) override;
   summary_idt insert_summary(itpt_summaryt *summary_given, const std::string & function_name) override;
 
+#ifdef PRODUCE_PROOF
+  // Replaces the non-linear terms and the unsupported calls in the stored summaries by fresh
+  // variables of the decider (see smtcheck_opensmt2t::abstract_non_linears); returns their number
+  std::size_t abstract_non_linears();
+#endif
+
   void set_decider(smtcheck_opensmt2t * _decider) {
       this->decider = _decider;
   }
@@ -3,6 +3,7 @@
 Module: Wrapper for OpenSMT2. Based on smtcheck_opensmt2s.
 
 \*******************************************************************/
+#include <cstring>
 #include <queue>
 #include <unordered_set>
 
@@ -392,22 +393,19 @@ Function: smtcheck_opensmt2t::create_unsupported_uf_call
  Purpose:
 
  *  If not exist yet, creates a new declartion in OpenSMT with 
- *  function name+size of args+type. 
+ *  the operator and the sorts of its result and arguments. 
  *  Add a new ptref of the use for this expression
 \*******************************************************************/
 PTRef smtcheck_opensmt2t::create_unsupported_uf_call(const exprt &expr)
 {  
-    // Interface function - declare_unsupported_function shall work for any solver 
-    // KE: do not refactor and sent args to the method, shall work for any solver!
-    std::string decl_str = unsupported_info.declare_unsupported_function(expr);
-    if (decl_str.size() == 0)
-        return PTRef_Undef;
-    
-    SymRef decl = unsupported_info.get_declaration(decl_str);
-    
+    // Convert the arguments once, the declaration is found by the sorts
     vec<PTRef> args;
     get_function_args(expr, args);
     
+    SymRef decl = unsupported_info.declare_unsupported_function(expr.id(), get_smtlib_datatype(expr.type()), args);
+    if (decl == SymRef_Undef)
+        return PTRef_Undef;
+    
     return mkFun(decl,args);
 }
 
@@ -536,6 +534,67 @@ std::set<PTRef> smtcheck_opensmt2t::get_non_linears() const
     return ret;
 }
 
+/*******************************************************************\
+
+Function: smtcheck_opensmt2t::abstract_non_linears
+
+ Purpose: for summary-theory refinement, the terms another theory cannot
+ read become fresh variables; the same term gets the same variable in
+ all the summaries
+
+\*******************************************************************/
+PTRef smtcheck_opensmt2t::abstract_non_linears(PTRef root, std::unordered_map<PTRef, PTRef, PTRefHash> & abstraction)
+{
+    std::unordered_map<PTRef, PTRef, PTRefHash> rebuilt;
+    return abstract_non_linears_rec(root, abstraction, rebuilt);
+}
+
+PTRef smtcheck_opensmt2t::abstract_non_linears_rec(PTRef ptref, std::unordered_map<PTRef, PTRef, PTRefHash> & abstraction,
+                                                   std::unordered_map<PTRef, PTRef, PTRefHash> & rebuilt)
+{
+    auto done = rebuilt.find(ptref);
+    if (done != rebuilt.end()) {
+        return done->second;
+    }
+    if (logic->isVar(ptref) || logic->isConstant(ptref)) {
+        return ptref;
+    }
+    auto abstracted = abstraction.find(ptref);
+    if (abstracted != abstraction.end()) {
+        return abstracted->second;
+    }
+    const std::string & prefix = HifrogStringUnsupportOpConstants::UNSUPPORTED_PREFIX_FUNC_NAME;
+    if ((can_have_non_linears() && is_non_linear_operator(ptref)) ||
+        std::strncmp(logic->getSymName(ptref), prefix.c_str(), prefix.size()) == 0) {
+        std::string name = get_unsupported_registry().fresh_var_name_nonlinear();
+        PTRef var = logic->mkVar(logic->getSortRef(ptref), name.c_str());
+        abstraction.emplace(ptref, var);
+        return var;
+    }
+    // the children are copied, building the new terms may move the term store
+    const SymRef symb = logic->getPterm(ptref).symb();
+    vec<PTRef> args;
+    for (int i = 0; i < logic->getPterm(ptref).size(); ++i) {
+        args.push(logic->getPterm(ptref)[i]);
+    }
+    bool changed = false;
+    for (int i = 0; i < args.size(); ++i) {
+        PTRef arg = abstract_non_linears_rec(args[i], abstraction, rebuilt);
+        changed |= arg != args[i];
+        args[i] = arg;
+    }
+    PTRef result = ptref;
+    if (changed) {
+        char *msg = nullptr;
+        result = logic->insertTerm(symb, args, &msg);
+        if (msg != nullptr) {
+            free(msg);
+        }
+    }
+    rebuilt.emplace(ptref, result);
+    return result;
+}
+
 //Wrapper
 void smtcheck_opensmt2t::generalize_summary(itpt * interpolant, std::vector<symbol_exprt> & common_symbols) {
     auto smt_itp = dynamic_cast<smt_itpt*>(interpolant);
@@ -581,6 +640,9 @@ void smtcheck_opensmt2t::generalize_summary(smt_itpt & interpolant, std::vector<
     PTRef old_root = interpolant.getInterpolant();
     PTRef new_root;
     logic->varsubstitute(old_root, subst, new_root);
+    if (minimize_summaries) {
+        new_root = minimize_summary(new_root);
+    }
 
 //    std::cout << "; Old formula: " << logic->printTerm(old_root) << '\n';
 //    std::cout << "; New formula " << logic->printTerm(new_root) << std::endl;
@@ -588,11 +650,124 @@ void smtcheck_opensmt2t::generalize_summary(smt_itpt & interpolant, std::vector<
     //the only place to set the body of summary
     tt.setBody(new_root);
 }
+
+const std::size_t smtcheck_opensmt2t::max_minimized_conjuncts;
+
+/*******************************************************************\
+Function: smtcheck_opensmt2t::minimize_summary
+
+ Purpose: Removes the redundant conjuncts of a (generalized) summary.
+ The top-level conjunction is flattened, duplicates and true conjuncts
+ are dropped, and the rest is rebuilt with the logic's simplifying mkAnd.
+ Before that, every conjunct c is checked against the conjuncts still
+ kept: if (kept \ {c}) /\ !c is UNSAT, c is implied and dropped. The
+ checks run in one scratch solver over the same logic, every check
+ between push and pop; the main solver (and its proof) is not touched.
+ Summaries with more than max_minimized_conjuncts conjuncts are only
+ flattened, which is reported as a warning.
+\*******************************************************************/
+PTRef smtcheck_opensmt2t::minimize_summary(PTRef root)
+{
+    std::vector<PTRef> conjuncts;
+    std::unordered_set<PTRef, PTRefHash> seen;
+    std::vector<PTRef> queue{root};
+    while (!queue.empty()) {
+        PTRef tr = queue.back();
+        queue.pop_back();
+        if (!seen.insert(tr).second) { continue; }
+        if (logic->isAnd(tr)) {
+            for (int i = 0; i < logic->getPterm(tr).size(); i++) {
+                queue.push_back(logic->getPterm(tr)[i]);
+            }
+        }
+        else if (!logic->isTrue(tr)) {
+            conjuncts.push_back(tr);
+        }
+    }
+
+    std::vector<bool> kept(conjuncts.size(), true);
+    if (conjuncts.size() > max_minimized_conjuncts) {
+        // the implication checks are quadratic, skip them for big summaries
+        std::cerr << "WARNING: summary with " << conjuncts.size() << " conjuncts not minimized (limit is "
+                  << max_minimized_conjuncts << ")." << std::endl;
+    }
+    else if (conjuncts.size() > 1) {
+        // one scratch solver for all the checks, each check in its own backtracking point
+        SMTConfig scratch_config;
+        MainSolver scratch_solver(*logic, scratch_config, "summary minimization");
+        for (std::size_t i = 0; i < conjuncts.size(); ++i) {
+            vec<PTRef> query;
+            for (std::size_t j = 0; j < conjuncts.size(); ++j) {
+                if (j != i && kept[j]) { query.push(conjuncts[j]); }
+            }
+            query.push(logic->mkNot(conjuncts[i]));
+
+            scratch_solver.push();
+            char *msg = nullptr;
+            scratch_solver.insertFormula(logic->mkAnd(query), &msg);
+            if (msg != nullptr) {
+                free(msg);
+            }
+            if (s_False == scratch_solver.check()) {
+                kept[i] = false;
+            }
+            scratch_solver.pop();
+        }
+    }
+
+    vec<PTRef> remaining;
+    for (std::size_t i = 0; i < conjuncts.size(); ++i) {
+        if (kept[i]) { remaining.push(conjuncts[i]); }
+    }
+#ifdef DEBUG_SMT_ITP
+    std::cout << "; Summary minimization kept " << remaining.size() << " of "
+              << conjuncts.size() << " conjuncts" << std::endl;
+#endif
+    return logic->mkAnd(remaining);
+}
 #endif // PRODUCE_PROOF
 
-PTRef smtcheck_opensmt2t::instantiate(smt_itpt const & smt_itp, const std::vector<symbol_exprt> & symbols) {
-    const auto & sumTemplate = smt_itp.getTempl();
+/*******************************************************************\
+ Purpose: The name of a summary argument as expected on the interface,
+ i.e. without the suffix distinguishing input and output globals.
+ It is computed once per argument term.
+\*******************************************************************/
+const irep_idt & smtcheck_opensmt2t::get_summary_argument_name(PTRef argument) {
+    auto it = summary_argument_names.find(argument);
+    if (it == summary_argument_names.end()) {
+        std::string argument_name { logic->getSymName(argument) };
+        if(isGlobalName(argument_name)){
+            argument_name = stripGlobalSuffix(argument_name);
+        }
+        it = summary_argument_names.emplace(argument, irep_idt(argument_name)).first;
+    }
+    return it->second;
+}
+
+/*******************************************************************\
+ Purpose: Validates the template against the interface: the arguments
+ are matched with the symbols by position, their names only validate
+ the match. The validation is done once per template and interface
+ shape (the original names of the symbols), not once per call site.
+\*******************************************************************/
+smtcheck_opensmt2t::summary_layoutt & smtcheck_opensmt2t::get_summary_layout(
+        const SummaryTemplate & sumTemplate, const std::vector<symbol_exprt> & symbols) {
     const auto& args = sumTemplate.getArgs();
+    std::pair<std::vector<PTRef>, std::vector<irep_idt>> key;
+    key.first.reserve(args.size() + 1);
+    key.first.push_back(sumTemplate.getBody());
+    for (int i = 0; i < args.size(); ++i) {
+        key.first.push_back(args[i]);
+    }
+    key.second.reserve(symbols.size());
+    for (const auto & symbol : symbols) {
+        key.second.push_back(get_symbol_name(symbol));
+    }
+
+    auto it = summary_layouts.find(key);
+    if (it != summary_layouts.end()) {
+        return it->second;
+    }
 
     // summary is defined as a function over arguments to Bool
     // we need to match the arguments with the symbols and insert_substituted
@@ -600,39 +775,66 @@ PTRef smtcheck_opensmt2t::instantiate(smt_itpt const & smt_itp, const std::vecto
     // and they are in the same order
     // one exception is if global variable is both on input and output, then the out argument was distinguished
 
-    Map<PTRef, PtAsgn, PTRefHash> subst;
     if (symbols.size() != static_cast<std::size_t>(args.size())) {
         throw SummaryInvalidException("Number of interface symbols do not match the summary signature!\n");
-        for (size_t i =0 ; i < symbols.size() ; i++) {
-            std::string symbol_name{quote_if_necessary(get_symbol_name(symbols[i]).c_str())};
-            std::cout << "symbol: " << symbol_name << "\n";
-        }
-        for (size_t i =0 ; i < args.size() ; i++) {
-            std::cout << "\nargs: " <<logic->pp(args[i]) <<std::endl;
-        }
     }
     for(std::size_t i = 0; i < symbols.size(); ++i){
-        std::string symbol_name { get_symbol_name(symbols[i]).c_str() };
-        PTRef argument = args[i];
+        const irep_idt & symbol_name = key.second[i];
         //Name read from summary
-        std::string argument_name { logic->getSymName(argument) };
-        if(isGlobalName(argument_name)){
-            argument_name = stripGlobalSuffix(argument_name);
-        }
+        const irep_idt & argument_name = get_summary_argument_name(args[i]);
         if(symbol_name != argument_name){
             std::stringstream ss;
             ss << "Argument name read from summary do not match expected symbol name!\n"
                << "Expected symbol name: " << symbol_name << "\nName read from summary: " << argument_name <<"\n";
             throw SummaryInvalidException(ss.str());
         }
-        PTRef symbol_ptref = expression_to_ptref(symbols[i]);
-        subst.insert(argument, PtAsgn(symbol_ptref, l_True));
+    }
+    summary_layoutt layout;
+    layout.args.assign(key.first.begin() + 1, key.first.end());
+    return summary_layouts.emplace(std::move(key), std::move(layout)).first->second;
+}
+
+/*******************************************************************\
+ Purpose: Instantiates the summary over the given interface symbols
+ (or over the values known at the call site). The substitution of the
+ same template body by the same terms yields the same term, so the
+ results are cached per layout; at most max_cached_instances of them.
+\*******************************************************************/
+PTRef smtcheck_opensmt2t::instantiate(smt_itpt const & smt_itp, const std::vector<symbol_exprt> & symbols,
+                                      const std::vector<exprt> * values) {
+    const auto & sumTemplate = smt_itp.getTempl();
+    summary_layoutt & layout = get_summary_layout(sumTemplate, symbols);
+
+    std::vector<PTRef> terms;
+    terms.reserve(symbols.size());
+    for(std::size_t i = 0; i < symbols.size(); ++i){
+        // the argument with a known value is replaced by the value directly (no need to declare the symbol);
+        // the logic simplifies the terms built during the substitution
+        bool known_value = values && i < values->size() && (*values)[i].is_not_nil();
+        terms.push_back(known_value ? expression_to_ptref((*values)[i]) : expression_to_ptref(symbols[i]));
+    }
+
+    auto cached = layout.instances.find(terms);
+    if (cached != layout.instances.end()) {
+        return cached->second;
     }
 
     // do the actual substitution
-    PTRef old_root = sumTemplate.getBody();
+    Map<PTRef, PtAsgn, PTRefHash> subst;
+    for(std::size_t i = 0; i < symbols.size(); ++i){
+        subst.insert(layout.args[i], PtAsgn(terms[i], l_True));
+    }
     PTRef new_root;
-    logic->varsubstitute(old_root, subst, new_root);
+    logic->varsubstitute(sumTemplate.getBody(), subst, new_root);
+    if (cached_instances >= max_cached_instances) {
+        // the cache only saves the substitution, the instances stay in the logic
+        for (auto & entry : summary_layouts) {
+            entry.second.instances.clear();
+        }
+        cached_instances = 0;
+    }
+    layout.instances.emplace(std::move(terms), new_root);
+    ++cached_instances;
     return new_root;
 }
 //replaces the function with the summary body(new root)
@@ -648,6 +850,19 @@ void smtcheck_opensmt2t::insert_substituted(const itpt & itp, const std::vector<
     ptrefs.push_back(old_root); // MB: needed in sumtheoref to spot non-linear expressions in the summaries
 }
 
+//inserts the summary specialized to the values of the interface symbols known at the call site
+void smtcheck_opensmt2t::insert_specialized(const itpt & itp, const std::vector<symbol_exprt> & symbols,
+                                            const std::vector<exprt> & values) {
+    assert(!itp.is_trivial());
+    assert(logic);
+    auto const & smt_itp = static_cast<smt_itpt const &> (itp);
+    PTRef new_root = instantiate(smt_itp, symbols, &values);
+    this->set_to_true(new_root);
+
+    PTRef old_root = smt_itp.getTempl().getBody();
+    ptrefs.push_back(old_root); // MB: needed in sumtheoref to spot non-linear expressions in the summaries
+}
+
 void smtcheck_opensmt2t::substitute_negate_insert(const itpt & itp, const std::vector<symbol_exprt> & symbols) {
     assert(!itp.is_trivial());
     assert(logic);
@@ -687,14 +902,14 @@ PTRef smtcheck_opensmt2t::complex_symbol_to_ptref(const exprt& expr){
     return unsupported_to_var(expr);
 }
 
-PTRef smtcheck_opensmt2t::get_from_cache(const exprt & expr) const {
-    const auto it = expression_to_ptref_map.find(expr);
-    return it == expression_to_ptref_map.end() ? PTRef_Undef : it->second;
+PTRef smtcheck_opensmt2t::get_from_cache(const exprt & expr) {
+    const PTRef * cached = expression_to_ptref_map.find(expr);
+    return cached == nullptr ? PTRef_Undef : *cached;
 }
 
 void smtcheck_opensmt2t::store_to_cache(const exprt & expr, PTRef ptref) {
-    assert(expression_to_ptref_map.find(expr) == expression_to_ptref_map.end());
-    expression_to_ptref_map[expr] = ptref;
+    assert(!expression_to_ptref_map.contains(expr));
+    expression_to_ptref_map.insert(expr, ptref);
 }
 
 exprt smtcheck_opensmt2t::get_value(const exprt & expr) {
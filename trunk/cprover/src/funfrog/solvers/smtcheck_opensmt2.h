@@ -12,10 +12,12 @@ Module: Wrapper for OpenSMT2
 #include "../utils/unsupported_operations_opensmt2.h" // KE: shall move all the code of unsupported here
 #include "smt_itp.h"
 #include <funfrog/utils/expressions_utils.h>
+#include <funfrog/utils/expr_cache.h>
 #include <util/symbol.h>
 #include <solvers/prop/literal.h>
 
 #include <map>
+#include <unordered_map>
 #include <memory>
 #include <funfrog/summary_store_fwd.h>
 
@@ -103,6 +105,10 @@ public:
     void assert_literal(const FlaRef lit) override{
         set_to_true(flaref_to_ptref(lit));
     }
+
+    void retain_expressions(const std::unordered_set<const irept::dt *> & used) override {
+        expression_to_ptref_map.retain(used);
+    }
   
 #ifdef PRODUCE_PROOF
     virtual void get_interpolant(const interpolation_taskt& partition_ids,
@@ -121,13 +127,25 @@ public:
 
     void generalize_summary(smt_itpt & interpolant, std::vector<symbol_exprt> & common_symbols);
 
+    // Drops the top-level conjuncts implied by the other ones
+    PTRef minimize_summary(PTRef root);
+
+    // Bigger summaries are not checked for implied conjuncts by minimize_summary
+    static const std::size_t max_minimized_conjuncts = 64;
+
     std::set<PTRef> get_non_linears() const;
+
+    // Replaces the non-linear terms and the calls of the unsupported functions (uns_*) by fresh variables;
+    // the abstraction maps the replaced terms to their variables and is shared by the calls
+    PTRef abstract_non_linears(PTRef root, std::unordered_map<PTRef, PTRef, PTRefHash> & abstraction);
     int getAtoms( PTRef tr) const;
     bool isConjunctive(PTRef ptref) const;
     bool isDisjunctive(PTRef ptref) const;
 #endif
 
     void insert_substituted(const itpt & itp, const std::vector<symbol_exprt> & symbols) override;
+    void insert_specialized(const itpt & itp, const std::vector<symbol_exprt> & symbols,
+                            const std::vector<exprt> & values) override;
     void substitute_negate_insert(const itpt & itp, const std::vector<symbol_exprt> & symbols) override;
   
     // Common to all
@@ -138,6 +156,9 @@ public:
 
     void dump_function(std::ostream& out, const SummaryTemplate & templ);
 
+    // Numbering of the unsupported operations shared with the other solvers of the verification
+    unsupported_registryt & get_unsupported_registry() { return unsupported_info.get_registry(); }
+
       virtual bool is_overapprox_encoding() const override
       { return (unsupported_info.has_unsupported_vars() && !has_overappox_mapping());}
 
@@ -153,7 +174,7 @@ protected:
     /****************** Conversion methods - methods for converting expressions to OpenSMT's PTRefs ***************/
     virtual PTRef expression_to_ptref(const exprt& expr) = 0;
 
-    PTRef get_from_cache(const exprt& expr) const;
+    PTRef get_from_cache(const exprt& expr);
 
     void store_to_cache(const exprt& expr, PTRef ptref);
 
@@ -183,14 +204,36 @@ protected:
     
   /* ***************************************************************************************************************/
 
-    PTRef instantiate(smt_itpt const & summary, const std::vector<symbol_exprt> & symbols);
+    PTRef instantiate(smt_itpt const & summary, const std::vector<symbol_exprt> & symbols,
+                      const std::vector<exprt> * values = nullptr);
+
+    // Base names of the summary arguments (global suffix stripped), computed once per argument
+    std::unordered_map<PTRef, irep_idt, PTRefHash> summary_argument_names;
+
+    const irep_idt & get_summary_argument_name(PTRef argument);
+
+    // A template validated against an interface (the original names of the interface symbols);
+    // the results of instantiate are kept per layout, keyed by the substituted terms
+    struct summary_layoutt {
+        std::vector<PTRef> args;
+        std::map<std::vector<PTRef>, PTRef> instances;
+    };
+    // keyed by the template body followed by its arguments, and the names of the interface symbols
+    std::map<std::pair<std::vector<PTRef>, std::vector<irep_idt>>, summary_layoutt> summary_layouts;
+    // The instances of all the layouts are dropped when there are this many of them
+    static const std::size_t max_cached_instances = 1 << 16;
+    std::size_t cached_instances = 0;
+
+    summary_layoutt & get_summary_layout(const SummaryTemplate & sumTemplate,
+                                         const std::vector<symbol_exprt> & symbols);
 
     std::vector<SummaryTemplate> summary_templates;
 
     using expr_hasht = irep_hash;
     //using expr_hasht = irep_full_hash;
     std::unordered_map<exprt, PTRef, expr_hasht> unsupported_expr2ptrefMap;
-    std::unordered_map<exprt, PTRef, expr_hasht> expression_to_ptref_map;
+    // converted expressions, looked up by irep node identity first
+    expr_cachet<PTRef> expression_to_ptref_map;
 
     unsupported_operations_opensmt2t unsupported_info;
 
@@ -210,6 +253,11 @@ protected:
 
     PTRef mkFun(SymRef decl, const vec<PTRef>& args); // Common to all
 
+#ifdef PRODUCE_PROOF
+    PTRef abstract_non_linears_rec(PTRef ptref, std::unordered_map<PTRef, PTRef, PTRefHash> & abstraction,
+                                   std::unordered_map<PTRef, PTRef, PTRefHash> & rebuilt);
+#endif
+
     template<typename Pred, typename Cont_Ret, typename Cont_Cache>
     void collect_rec(const Pred predicate, PTRef ptref, Cont_Ret& collected, Cont_Cache& seen) const {
       if (contains(seen, ptref)) { return; } // already processed
@@ -225,6 +273,9 @@ protected:
     }
 
 #ifdef PRODUCE_PROOF
+    // Minimize the summaries in generalize_summary (see minimize_summary)
+    bool minimize_summaries = false;
+
     void setup_reduction();
 
     void setup_interpolation();
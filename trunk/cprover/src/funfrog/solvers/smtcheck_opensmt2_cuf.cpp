@@ -31,6 +31,7 @@ void smtcheck_opensmt2t_cuf::initializeSolver(solver_optionst solver_options, co
     // Initialize parameters
     this->verbosity = solver_options.m_verbosity;
     set_random_seed(solver_options.m_random_seed);
+    unsupported_info.set_registry(solver_options.m_unsupported_registry);
   
 #ifdef PRODUCE_PROOF  
     // TODO: add sets once interpolation is working for LIA
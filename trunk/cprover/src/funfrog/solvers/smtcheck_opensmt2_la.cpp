@@ -394,6 +394,121 @@ PTRef smtcheck_opensmt2t_la::unsupported_to_var(const exprt &expr)
 }
 
 
+/*******************************************************************\
+
+Function: smtcheck_opensmt2t_la::type_bounds_strings
+
+  Inputs: a numeric type
+
+ Outputs: false if the type has no supported bounds
+
+ Purpose: The bounds of the values of the type, as decimal strings
+
+\*******************************************************************/
+bool smtcheck_opensmt2t_la::type_bounds_strings(
+        const typet & var_type,
+        std::string & lower_bound,
+        std::string & upper_bound)
+{
+    const irep_idt type_id_c = var_type.get("#c_type");
+    const irep_idt &type_id=var_type.id_string();
+    int size = var_type.get_size_t("width");
+
+    // Start checking what it is
+    if (type_id_c == ID_signed_char)
+    {
+        // Is from -128 to 127
+    	lower_bound = "-128";
+    	upper_bound = "127";
+    }
+    else if (type_id_c == ID_unsigned_char)
+    {
+        // Is from 0 to 255
+    	lower_bound = "0";
+    	upper_bound = "255";
+    }    
+    else if (type_id_c == ID_char)
+    {
+    	lower_bound = ((type_id==ID_signedbv) ? "-128" : "0");
+        upper_bound = ((type_id==ID_signedbv) ? "127" : "255");
+    }
+    else if(type_id==ID_integer || type_id==ID_natural)
+    {
+    	assert(0); // need to see an example!
+    }
+    else if(type_id==ID_rational)
+    {
+    	assert(0); // need to see an example!
+    }
+    else if(type_id==ID_unsignedbv) // unsigned int = 32, unsigned long = 64
+    {
+        // The implementation contains support for: 16,32 and 64 bits only
+        if (size != 16 && size != 32 && size != 64) return false;
+        lower_bound = "0";
+        upper_bound = ((size == 64) ? "18446744073709551615" :
+                       ((size == 32) ? "4294967295" : "65535"));
+    }
+    else if(type_id==ID_signedbv) // int = 32, long = 64
+    {
+        // The implementation contains support for: 16,32 and 64 bits only
+        if (size != 16 && size != 32 && size != 64) return false;
+        lower_bound = ((size == 64) ? "-9223372036854775808" :
+                       ((size == 32) ? "-2147483648" : "-32768"));
+        upper_bound = ((size == 64) ? "9223372036854775807" :
+                       ((size == 32) ? "2147483647" : "32767"));
+    }
+    else if(type_id==ID_fixedbv)
+    {
+    	assert(0); // need to see an example!
+    }
+    else if(type_id==ID_floatbv) // float = 32, double = 64
+    {
+        // The implementation contains support to: 32 and 64 bits only
+        assert("Data numerical type constraints for bytes are valid for 32,64,128,256 bit-width or up" 
+                    && (size == 32 || size == 64));
+        
+    	lower_bound = ((size==32) ?
+				("-" + create_bound_string("34028234", 38)) : ("-" + create_bound_string("17976931348623158", 308)));
+    	upper_bound = ((size==32) ?
+				create_bound_string("34028233", 38) : create_bound_string("17976931348623157", 308));
+    }
+    else
+    {
+    	assert(0); // need to see an example!
+    }
+    return true;
+}
+
+/*******************************************************************\
+
+Function: smtcheck_opensmt2t_la::get_type_bounds
+
+  Inputs:
+
+ Outputs: the bounds of the type, PTRef_Undef if it has none
+
+ Purpose: The constants of the bounds are created once per type
+
+\*******************************************************************/
+const smtcheck_opensmt2t_la::type_boundst & smtcheck_opensmt2t_la::get_type_bounds(const typet & var_type)
+{
+    auto it = type_bounds.find(var_type);
+    if (it != type_bounds.end()) { return it->second; }
+
+    type_boundst bounds {PTRef_Undef, PTRef_Undef};
+    std::string lower_bound;
+    std::string upper_bound;
+    if (type_bounds_strings(var_type, lower_bound, upper_bound)) {
+        bounds.lower = lalogic->mkConst(lower_bound.c_str());
+        bounds.upper = lalogic->mkConst(upper_bound.c_str());
+#ifdef SMT_DEBUG_VARS_BOUNDS
+        cout << "; Bounds " << lower_bound << " and " << upper_bound << " for type "
+            << var_type.get("#c_type") << " " << var_type.get_size_t("width") << "bits" << endl;
+#endif
+    }
+    return type_bounds.emplace(var_type, bounds).first->second;
+}
+
 /*******************************************************************\
 
 Function: smtcheck_opensmt2t_la::create_constraints2type
@@ -407,11 +522,10 @@ Function: smtcheck_opensmt2t_la::create_constraints2type
 \*******************************************************************/
 PTRef smtcheck_opensmt2t_la::create_constraints2type(
         const PTRef var,
-        std::string lower_b,
-        std::string upper_b)
+        const type_boundst & bounds)
 {
-    PTRef ptl1 = lalogic->mkNumLeq(lalogic->mkConst(lower_b.c_str()), var);
-    PTRef ptl2 = lalogic->mkNumLeq(var, lalogic->mkConst(upper_b.c_str()));
+    PTRef ptl1 = lalogic->mkNumLeq(bounds.lower, var);
+    PTRef ptl2 = lalogic->mkNumLeq(var, bounds.upper);
 
     return logic->mkAnd(ptl1, ptl2);
 }
@@ -429,17 +543,15 @@ Function: smtcheck_opensmt2t_la::push_assumes2type
 \*******************************************************************/
 void smtcheck_opensmt2t_la::push_assumes2type(
         const PTRef var,
-        std::string lower_b,
-        std::string upper_b)
+        const type_boundst & bounds)
 {
     if (type_constraints_level < 1 ) return;
-    PTRef ptr = create_constraints2type(var, lower_b, upper_b);
+    PTRef ptr = create_constraints2type(var, bounds);
     set_to_true(ptr);
 
 #ifdef SMT_DEBUG_VARS_BOUNDS
     char *s = logic->printTerm(ptr);
     std::cout << "; For 'Assume' Constraints Created OpenSMT2 formula " << s << endl;
-    std::cout << "; For Bounds " << lower_b.c_str() << " and " << upper_b.c_str() << endl;
     free(s); s=nullptr;
 #endif
 }
@@ -457,49 +569,23 @@ Function: smtcheck_opensmt2t_la::push_asserts2type
 \*******************************************************************/
 void smtcheck_opensmt2t_la::push_asserts2type(
         const PTRef var,
-        std::string lower_b,
-        std::string upper_b)
+        const type_boundst & bounds)
 {
     if (type_constraints_level < 2) return;
 
-    // Else add the checks
-    PTRef ptr = create_constraints2type(var, lower_b, upper_b);
-    ptr_assert_var_constraints = logic->mkAnd(ptr_assert_var_constraints, ptr);
+    // Else add the checks; conjoined all at once in get_and_clear_var_constraints
+    PTRef ptr = create_constraints2type(var, bounds);
+    assert_var_constraints.push(ptr);
 
 #ifdef SMT_DEBUG_VARS_BOUNDS
     char *s = logic->printTerm(ptr);
     std::cout << "; For 'Assert' Constraints Created OpenSMT2 formula " << s << endl;
-    std::cout << "; Pushed Formula For Bounds " << lower_b.c_str() << " and " << upper_b.c_str() << endl;
     free(s); s=nullptr;
 #endif
 }
 
 /*******************************************************************\
 
-Function: smtcheck_opensmt2t_la::push_constraints2type
-
-  Inputs:
-
- Outputs:
-
- Purpose:
-
-\*******************************************************************/
-bool smtcheck_opensmt2t_la::push_constraints2type(
-        const PTRef var,
-        bool is_non_det,
-        std::string lower_b,
-        std::string upper_b)
-{
-    if (is_non_det) // Add Assume
-        push_assumes2type(var, lower_b, upper_b);
-    else // Add assert
-        push_asserts2type(var, lower_b, upper_b);
-    return true;
-}
-
-/*******************************************************************\
-
 Function: smtcheck_opensmt2t_la::add_constraints2type
 
   Inputs:
@@ -511,153 +597,53 @@ Function: smtcheck_opensmt2t_la::add_constraints2type
 \*******************************************************************/
 void smtcheck_opensmt2t_la::add_constraints2type(const exprt & expr, const PTRef var)
 {
-    typet var_type = expr.type(); // Get the current type
-    const irep_idt type_id_c = var_type.get("#c_type");
-    const irep_idt &type_id=var_type.id_string();
-    
 #ifdef SMT_DEBUG_VARS_BOUNDS
-    std::cout << "; Try to add type constraints to " << type_id << std::endl;
+    std::cout << "; Try to add type constraints to " << expr.type().id() << std::endl;
 #endif
     
     /* Test if needs to add */
     if(!is_number(expr.type())) return; // KE: shall also catch the case of char
-    if (var_type.is_nil()) return;
+    if (expr.type().is_nil()) return;
     if (expr.is_constant()) return;
 
     // Check the id is a var
     assert((expr.id() == ID_nondet_symbol) || (expr.id() == ID_symbol));
 
-    // Start building the constraints
+    bool is_non_det = (expr.id() == ID_nondet_symbol);
+    if (type_constraints_level < (is_non_det ? 1u : 2u)) return;
+
+    // Only the variables whose range can matter (see set_bounded_symbols)
+    if (bounds_restricted && bounded_symbols.find(expr.get(ID_identifier)) == bounded_symbols.end()) {
+        return;
+    }
+
+    const type_boundst & bounds = get_type_bounds(expr.type());
+    if (bounds.lower == PTRef_Undef) return;
+
 #ifdef SMT_DEBUG_VARS_BOUNDS
     std::cout << "; For variable " << expr.get(ID_identifier) << " in partition " << partition_count
-			<< " try to identify this type "<< var_type.pretty()
 			<< ((expr.id() == ID_nondet_symbol) ? " that is non-det symbol" : " that is a regular symbol")
 			<< endl;
 #endif
 
-    //gets the property
-    int size = var_type.get_size_t("width");
-    bool is_non_det = (expr.id() == ID_nondet_symbol);
-#ifdef SMT_DEBUG_VARS_BOUNDS   
-    bool is_add_constraints = false;
-#endif
+    if (is_non_det) // Add Assume
+        push_assumes2type(var, bounds);
+    else // Add assert
+        push_asserts2type(var, bounds);
+}
 
-    // Start checking what it is
-    if (type_id_c == ID_signed_char)
-    {
-#ifdef SMT_DEBUG_VARS_BOUNDS
-    	cout << "; Adding new constraint for char signed" << endl;
-#endif
-        // Is from -128 to 127
-    	std::string lower_bound = "-128";
-    	std::string upper_bound = "127";
-#ifdef SMT_DEBUG_VARS_BOUNDS   
-    	is_add_constraints = 
-#endif 
-        push_constraints2type(var, is_non_det, lower_bound, upper_bound);
-    }
-    else if (type_id_c == ID_unsigned_char)
-    {
-#ifdef SMT_DEBUG_VARS_BOUNDS
-    	cout << "; Adding new constraint for char unsigned" << endl;
-#endif
-        // Is from 0 to 255
-    	std::string lower_bound = "0";
-    	std::string upper_bound = "255";
-#ifdef SMT_DEBUG_VARS_BOUNDS   
-    	is_add_constraints = 
-#endif 
-        push_constraints2type(var, is_non_det, lower_bound, upper_bound);
-    }    
-    else if (type_id_c == ID_char)
-    {
-#ifdef SMT_DEBUG_VARS_BOUNDS
-    	cout << "; Adding new constraint for char " << ((type_id==ID_signedbv) ? "signed" : "unsigned") << endl;
-#endif
-    	std::string lower_bound = ((type_id==ID_signedbv) ? "-128" : "0");
-        std::string upper_bound = ((type_id==ID_signedbv) ? "127" : "255");
-        
-#ifdef SMT_DEBUG_VARS_BOUNDS   
-    	is_add_constraints = 
-#endif 
-        push_constraints2type(var, is_non_det, lower_bound, upper_bound);
-    }
-    else if(type_id==ID_integer || type_id==ID_natural)
-    {
-    	assert(0); // need to see an example!
-    }
-    else if(type_id==ID_rational)
-    {
-    	assert(0); // need to see an example!
-    }
-    else if(type_id==ID_unsignedbv) // unsigned int = 32, unsigned long = 64
-    {
-        // The implementation contains support for: 16,32 and 64 bits only
-        if (size == 16 || size == 32 || size == 64) {
-#ifdef SMT_DEBUG_VARS_BOUNDS
-            cout << "; Adding new constraint for unsigned " << ((size==32) ? "int" : "long") << endl;
-#endif
-            std::string lower_bound = "0";
-            std::string upper_bound = ((size == 64) ? "18446744073709551615" :
-                                       ((size == 32) ? "4294967295" : "65535"));
-#ifdef SMT_DEBUG_VARS_BOUNDS
-            is_add_constraints =
-#endif
-            push_constraints2type(var, is_non_det, lower_bound, upper_bound);
-        }
-    }
-    else if(type_id==ID_signedbv) // int = 32, long = 64
-    {
-        // The implementation contains support for: 16,32 and 64 bits only
-        if (size == 16 || size == 32 || size == 64) {
-#ifdef SMT_DEBUG_VARS_BOUNDS
-            cout << "; Adding new constraint for " << ((size==32) ? "int" : "long") << endl;
-#endif
-            std::string lower_bound = ((size == 64) ? "-9223372036854775808" :
-                                       ((size == 32) ? "-2147483648" : "-32768"));
-            std::string upper_bound = ((size == 64) ? "9223372036854775807" :
-                                       ((size == 32) ? "2147483647" : "32767"));
-#ifdef SMT_DEBUG_VARS_BOUNDS
-            is_add_constraints =
-#endif
-            push_constraints2type(var, is_non_det, lower_bound, upper_bound);
-        }
-    }
-    else if(type_id==ID_fixedbv)
-    {
-    	assert(0); // need to see an example!
-    }
-    else if(type_id==ID_floatbv) // float = 32, double = 64
-    {
-#ifdef SMT_DEBUG_VARS_BOUNDS
-    	cout << "; Adding new constraint for unsigned " << ((size==32) ? "float" : "double") << endl;
-#endif
-        // The implementation contains support to: 32 and 64 bits only
-        assert("Data numerical type constraints for bytes are valid for 32,64,128,256 bit-width or up" 
-                    && (size == 32 || size == 64));
-        
-    	std::string lower_bound = ((size==32) ?
-				("-" + create_bound_string("34028234", 38)) : ("-" + create_bound_string("17976931348623158", 308)));
-    	std::string upper_bound = ((size==32) ?
-				create_bound_string("34028233", 38) : create_bound_string("17976931348623157", 308));
-#ifdef SMT_DEBUG_VARS_BOUNDS   
-    	is_add_constraints = 
-#endif 
-        push_constraints2type(var, is_non_det, lower_bound, upper_bound);
-    }
-    else
-    {
-    	assert(0); // need to see an example!
-    }
+/*******************************************************************\
 
-    // For numbers add constraints of upper and lower bounds
-#ifdef SMT_DEBUG_VARS_BOUNDS
-    if (is_add_constraints)
-    	cout << "; Add bounds constraints for type "
-            << var_type.get("#c_type") << " "
-            << var_type.get_size_t("width") << "bits"
-            << endl;
-#endif
+Function: smtcheck_opensmt2t_la::set_bounded_symbols
+
+ Purpose: From now on, only the given symbols get the constraints of their
+ type; the others keep any value the solver likes
+
+\*******************************************************************/
+void smtcheck_opensmt2t_la::set_bounded_symbols(std::unordered_set<irep_idt> symbols)
+{
+    bounds_restricted = true;
+    bounded_symbols = std::move(symbols);
 }
 
 /*******************************************************************\
@@ -793,7 +779,9 @@ Function: smtcheck_opensmt2t_la::get_and_clear_var_constraints
 \*******************************************************************/
 FlaRef smtcheck_opensmt2t_la::get_and_clear_var_constraints()
 {
-    auto res = ptref_to_flaref(ptr_assert_var_constraints);
-    ptr_assert_var_constraints = logic->getTerm_true();
+    // a single flat conjunction instead of a chain of binary ones
+    auto res = ptref_to_flaref(assert_var_constraints.size() == 0 ? logic->getTerm_true()
+                                                                  : logic->mkAnd(assert_var_constraints));
+    assert_var_constraints.clear();
     return res;
 }
\ No newline at end of file
@@ -9,6 +9,9 @@ Module: Wrapper for OpenSMT2
 
 #include "smtcheck_opensmt2.h"
 
+#include <unordered_map>
+#include <unordered_set>
+
 class smtcheck_opensmt2t_la : public smtcheck_opensmt2t
 {
 public:
@@ -27,12 +30,28 @@ public:
     virtual PTRef expression_to_ptref(const exprt & expr) override;
     
     virtual SRef get_numeric_sort() const override {return lalogic->getSort_num();}
+
+    // at level 2 the constraints of the other symbols are asserted too
+    virtual bool can_restrict_type_constraints() const override { return type_constraints_level == 1; }
+
+    virtual void set_bounded_symbols(std::unordered_set<irep_idt> symbols) override;
     
 protected:
     LALogic* lalogic; // Extra var, inner use only - Helps to avoid dynamic cast!
 
-    // TODO: investigate if constraints should not be handled differently
-    PTRef ptr_assert_var_constraints;
+    // Assert side type constraints of the current partition
+    vec<PTRef> assert_var_constraints;
+
+    struct type_boundst {
+        PTRef lower;
+        PTRef upper;
+    };
+    // Constants of the bounds, per type
+    std::unordered_map<typet, type_boundst, irep_full_hash, irep_full_eq> type_bounds;
+
+    // If restricted, only these symbols get type constraints
+    bool bounds_restricted {false};
+    std::unordered_set<irep_idt> bounded_symbols;
 
     unsigned int type_constraints_level; // The level of checks in LA for numerical checks of overflow
 
@@ -63,26 +82,24 @@ protected:
     /* Set of functions that add constraints to take care of overflow and underflow */
     void add_constraints2type(const exprt & expr, const PTRef var); // add assume/assert on the data type
 
-    bool push_constraints2type(
-            const PTRef var,
-            bool is_non_det,
-            std::string lower_b,
-            std::string upper_b); // Push the constraints of a data type
+    bool type_bounds_strings(
+            const typet & var_type,
+            std::string & lower_bound,
+            std::string & upper_bound); // The bounds of a data type
+
+    const type_boundst & get_type_bounds(const typet & var_type); // Cached constants of the bounds
 
     void push_assumes2type(
             const PTRef var,
-            std::string lower_b,
-            std::string upper_b); // Push assume to the higher level
+            const type_boundst & bounds); // Push assume to the higher level
 
     void push_asserts2type(
             const PTRef var,
-            std::string lower_b,
-            std::string upper_b); // Push assert to the current partition
+            const type_boundst & bounds); // Push assert to the current partition
 
     PTRef create_constraints2type(
             const PTRef var,
-            std::string lower_b,
-            std::string upper_b); // create a formula with the constraints
+            const type_boundst & bounds); // create a formula with the constraints
 
 };
 
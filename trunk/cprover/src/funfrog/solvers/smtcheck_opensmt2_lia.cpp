@@ -25,6 +25,7 @@ void smtcheck_opensmt2t_lia::initializeSolver(solver_optionst solver_options, co
     // Initialize parameters
     this->verbosity = solver_options.m_verbosity;
     set_random_seed(solver_options.m_random_seed);
+    unsupported_info.set_registry(solver_options.m_unsupported_registry);
   
 #ifdef PRODUCE_PROOF  
     // TODO: add sets once interpolation is working for LIA
@@ -36,8 +37,6 @@ void smtcheck_opensmt2t_lia::initializeSolver(solver_optionst solver_options, co
 #endif // DISABLE_OPTIMIZATIONS  
     
 #ifndef NDEBUG
-    // To avoid issues with type constraints for LIA
-    ptr_assert_var_constraints = logic->getTerm_true();
     if (type_constraints_level > 0)
         std::cout << "Adding Type Constraints (" << type_constraints_level << ")" 
                 << ((type_constraints_level == 1 ? " for type constraints on non-deterministic input" : ""))
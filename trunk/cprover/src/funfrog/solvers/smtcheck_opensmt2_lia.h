@@ -17,7 +17,6 @@ public:
         lalogic = new LIALogic();
         logic.reset(lalogic);
         initializeSolver(solver_options, name);
-        ptr_assert_var_constraints = logic->getTerm_true();
     }
 
     virtual ~smtcheck_opensmt2t_lia(); // d'tor
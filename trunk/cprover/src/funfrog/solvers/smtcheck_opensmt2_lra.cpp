@@ -28,6 +28,7 @@ void smtcheck_opensmt2t_lra::initializeSolver(solver_optionst solver_options, co
     // Initialize parameters
     this->verbosity = solver_options.m_verbosity;
     set_random_seed(solver_options.m_random_seed);
+    unsupported_info.set_registry(solver_options.m_unsupported_registry);
   
 #ifdef PRODUCE_PROOF  
     this->itp_lra_algorithm.x = solver_options.m_lra_itp_algorithm;
@@ -37,6 +38,7 @@ void smtcheck_opensmt2t_lra::initializeSolver(solver_optionst solver_options, co
     this->reduction = solver_options.m_do_reduce;
     this->reduction_loops = solver_options.m_reduction_loops;
     this->reduction_graph = solver_options.m_reduction_graph;
+    this->minimize_summaries = solver_options.m_minimize_summaries;
 #endif
 #ifdef DISABLE_OPTIMIZATIONS
     set_dump_query(solver_options.m_dump_query);
@@ -45,8 +47,6 @@ void smtcheck_opensmt2t_lra::initializeSolver(solver_optionst solver_options, co
 #endif // DISABLE_OPTIMIZATIONS  
     
 #ifndef NDEBUG
-    // To avoid issues with type constraints for LRA
-    ptr_assert_var_constraints = logic->getTerm_true();
     if (type_constraints_level > 0)
         std::cout << "Adding Type Constraints (" << type_constraints_level << ")" 
                 << ((type_constraints_level == 1 ? " for type constraints on non-deterministic input" : ""))
@@ -15,7 +15,6 @@ public:
         smtcheck_opensmt2t_la(solver_options.m_type_constraints, name)   // base class ctor
     {
         initializeSolver(solver_options,name);
-        ptr_assert_var_constraints = logic->getTerm_true();
     }
 
     virtual ~smtcheck_opensmt2t_lra(); // d'tor
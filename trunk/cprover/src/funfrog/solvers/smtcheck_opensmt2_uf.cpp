@@ -43,6 +43,7 @@ void smtcheck_opensmt2t_uf::initializeSolver(const solver_optionst solver_option
   // Initialize parameters
   this->verbosity = solver_options.m_verbosity;
   set_random_seed(solver_options.m_random_seed);
+  unsupported_info.set_registry(solver_options.m_unsupported_registry);
   
 #ifdef PRODUCE_PROOF  
     this->itp_euf_algorithm.x = solver_options.m_uf_itp_algorithm;
@@ -51,6 +52,7 @@ void smtcheck_opensmt2t_uf::initializeSolver(const solver_optionst solver_option
     this->reduction = solver_options.m_do_reduce;
     this->reduction_loops = solver_options.m_reduction_loops;
     this->reduction_graph = solver_options.m_reduction_graph;
+    this->minimize_summaries = solver_options.m_minimize_summaries;
 #endif
 #ifdef DISABLE_OPTIMIZATIONS
     set_dump_query(solver_options.m_dump_query);
@@ -25,7 +25,8 @@ smtcheck_z3t::smtcheck_z3t(const solver_optionst _solver_options, std::string _l
       m_no_flarefs(0),
       m_no_flarefs_last_solved(0),
       m_pushed_formulas(0),
-      m_unsupported_info(unsupported_operations_z3t(_solver_options.m_store_unsupported_info, this)),
+      m_unsupported_info(unsupported_operations_z3t(_solver_options.m_store_unsupported_info, this,
+                                                    _solver_options.m_unsupported_registry)),
       m_solver_options(_solver_options)
 #ifdef DISABLE_OPTIMIZATIONS  
       ,
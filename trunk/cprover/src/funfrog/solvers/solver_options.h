@@ -9,7 +9,9 @@
 #ifndef SOLVER_OPTIONS_H
 #define SOLVER_OPTIONS_H
 
+#include <memory>
 #include <string>
+#include <funfrog/utils/unsupported_operations.h>
 
 class solver_optionst {
 public:
@@ -34,12 +36,16 @@ public:
     unsigned m_random_seed = 1;
     bool m_store_unsupported_info = false;
     bool m_incremental_solver = false; // TODO: make it work for OpenSMT2
+    // Shared by all solvers created with (copies of) these options
+    std::shared_ptr<unsupported_registryt> m_unsupported_registry = std::make_shared<unsupported_registryt>();
 
 #ifdef PRODUCE_PROOF
     unsigned m_certify=0;
     bool m_do_reduce=false;
     unsigned m_reduction_loops=3;
     unsigned m_reduction_graph=2;
+    // drop redundant conjuncts of the summaries before storing them
+    bool m_minimize_summaries=false;
     
     // Prop
     int m_prop_itp_algorithm=0;
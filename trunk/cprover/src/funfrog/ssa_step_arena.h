@@ -0,0 +1,189 @@
+/*******************************************************************
+
+ Module: Contiguous, chunked storage of SSA steps for the partitioning
+ target equation.
+
+ Steps are appended at the end only. Each chunk is allocated once with
+ a fixed capacity and never reallocated, so the address of a stored step
+ is stable for the lifetime of the arena. Partitions refer to their steps
+ by index ranges into the arena.
+
+ The directory of the chunks has a fixed first level, so appending does
+ not move anything read by the lookup of a stored step: another thread
+ may read the steps handed over to it while symex appends new ones.
+
+\*******************************************************************/
+
+#ifndef HIFROG_SSA_STEP_ARENA_H
+#define HIFROG_SSA_STEP_ARENA_H
+
+#include <goto-symex/symex_target_equation.h>
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class ssa_step_arenat {
+public:
+  using SSA_stept = symex_target_equationt::SSA_stept;
+
+  // Number of steps per chunk (power of two so that indexing is a shift and a mask)
+  static const std::size_t CHUNK_BITS = 10;
+  static const std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_BITS;
+
+  // Random access iterator over a range of indices of the arena
+  template<bool is_const>
+  class iteratort {
+  public:
+    using arenat = typename std::conditional<is_const, const ssa_step_arenat, ssa_step_arenat>::type;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = SSA_stept;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::conditional<is_const, const SSA_stept &, SSA_stept &>::type;
+    using pointer = typename std::conditional<is_const, const SSA_stept *, SSA_stept *>::type;
+
+    iteratort() = default;
+    iteratort(arenat * arena, std::size_t idx) : arena{arena}, idx{idx} {}
+    // allow conversion from non-const to const iterator
+    template<bool other_const, typename = typename std::enable_if<is_const && !other_const>::type>
+    iteratort(const iteratort<other_const> & other) : arena{other.arena}, idx{other.idx} {}
+
+    reference operator*() const { return (*arena)[idx]; }
+    pointer operator->() const { return &(*arena)[idx]; }
+    reference operator[](difference_type n) const { return (*arena)[idx + n]; }
+
+    iteratort & operator++() { ++idx; return *this; }
+    iteratort operator++(int) { iteratort tmp{*this}; ++idx; return tmp; }
+    iteratort & operator--() { --idx; return *this; }
+    iteratort operator--(int) { iteratort tmp{*this}; --idx; return tmp; }
+    iteratort & operator+=(difference_type n) { idx += n; return *this; }
+    iteratort & operator-=(difference_type n) { idx -= n; return *this; }
+    iteratort operator+(difference_type n) const { return iteratort{arena, idx + n}; }
+    iteratort operator-(difference_type n) const { return iteratort{arena, idx - n}; }
+    difference_type operator-(const iteratort & other) const {
+      return static_cast<difference_type>(idx) - static_cast<difference_type>(other.idx);
+    }
+
+    bool operator==(const iteratort & other) const { return idx == other.idx; }
+    bool operator!=(const iteratort & other) const { return idx != other.idx; }
+    bool operator<(const iteratort & other) const { return idx < other.idx; }
+
+    // Position of the step in the arena
+    std::size_t index() const { return idx; }
+
+  private:
+    arenat * arena {nullptr};
+    std::size_t idx {0};
+
+    template<bool> friend class iteratort;
+  };
+
+  using iterator = iteratort<false>;
+  using const_iterator = iteratort<true>;
+
+  // A [begin, end) sub-range of the arena, usable in range-for loops
+  template<typename Iter>
+  class ranget {
+  public:
+    ranget(Iter beg, Iter end) : beg{beg}, fin{end} {}
+    Iter begin() const { return beg; }
+    Iter end() const { return fin; }
+    std::size_t size() const { return fin - beg; }
+    bool empty() const { return beg == fin; }
+  private:
+    Iter beg;
+    Iter fin;
+  };
+
+  ssa_step_arenat() = default;
+  ssa_step_arenat(const ssa_step_arenat &) = delete;
+  ssa_step_arenat & operator=(const ssa_step_arenat &) = delete;
+
+  // Moves the step to the end of the arena, returns the stored step (its address is stable)
+  SSA_stept & push_back(SSA_stept && step) {
+    if (chunk_count == 0 || get_chunk(chunk_count - 1).size() == CHUNK_SIZE) {
+      assert(chunk_count < DIR_SIZE * DIR_SIZE);
+      auto & block = directory[chunk_count >> DIR_BITS];
+      if (!block) {
+        block.reset(new dir_blockt());
+      }
+      auto & new_chunk = (*block)[chunk_count & (DIR_SIZE - 1)];
+      new_chunk.reset(new chunkt());
+      new_chunk->reserve(CHUNK_SIZE);
+      ++chunk_count;
+    }
+    auto & chunk = get_chunk(chunk_count - 1);
+    assert(chunk.size() < chunk.capacity()); // no reallocation, addresses stay valid
+    chunk.push_back(std::move(step));
+    ++count;
+    return chunk.back();
+  }
+
+  // Moves all the steps from the given container to the end of the arena and empties the container
+  template<typename C>
+  void append(C & steps) {
+    for (auto & step : steps) {
+      push_back(std::move(step));
+    }
+    steps.clear();
+  }
+
+  SSA_stept & operator[](std::size_t idx) {
+    assert(idx < count);
+    return get_chunk(idx >> CHUNK_BITS)[idx & (CHUNK_SIZE - 1)];
+  }
+
+  const SSA_stept & operator[](std::size_t idx) const {
+    assert(idx < count);
+    return get_chunk(idx >> CHUNK_BITS)[idx & (CHUNK_SIZE - 1)];
+  }
+
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  void clear() {
+    for (auto & block : directory) {
+      block.reset();
+    }
+    chunk_count = 0;
+    count = 0;
+  }
+
+  iterator begin() { return iterator{this, 0}; }
+  iterator end() { return iterator{this, count}; }
+  const_iterator begin() const { return const_iterator{this, 0}; }
+  const_iterator end() const { return const_iterator{this, count}; }
+
+  ranget<iterator> range(std::size_t start_idx, std::size_t end_idx) {
+    assert(start_idx <= end_idx && end_idx <= count);
+    return ranget<iterator>{iterator{this, start_idx}, iterator{this, end_idx}};
+  }
+
+  ranget<const_iterator> range(std::size_t start_idx, std::size_t end_idx) const {
+    assert(start_idx <= end_idx && end_idx <= count);
+    return ranget<const_iterator>{const_iterator{this, start_idx}, const_iterator{this, end_idx}};
+  }
+
+private:
+  using chunkt = std::vector<SSA_stept>;
+
+  // Number of chunks per block of the directory; the directory has as many blocks
+  static const std::size_t DIR_BITS = 10;
+  static const std::size_t DIR_SIZE = std::size_t(1) << DIR_BITS;
+  using dir_blockt = std::array<std::unique_ptr<chunkt>, DIR_SIZE>;
+
+  chunkt & get_chunk(std::size_t chunk_idx) const {
+    return *(*directory[chunk_idx >> DIR_BITS])[chunk_idx & (DIR_SIZE - 1)];
+  }
+
+  std::array<std::unique_ptr<dir_blockt>, DIR_SIZE> directory;
+  std::size_t chunk_count {0};
+  // read by the asserts of other threads
+  std::atomic<std::size_t> count {0};
+};
+
+#endif //HIFROG_SSA_STEP_ARENA_H
@@ -50,9 +50,11 @@ void subst_scenariot::initialize_call_info(
 
       unsigned tgt_location = (*inst->targets.begin())->location_number;
       if(tgt_location < dst_location){    //means backwards goto : so loops still in continue
-        goto_ranges.push_back(std::make_pair(
-             global_loc - (dst_location - tgt_location),
-             global_loc));
+        if (record_locations) {
+          goto_ranges.push_back(std::make_pair(
+               global_loc - (dst_location - tgt_location),
+               global_loc));
+        }
         //std::cout << "backwards goto: " << global_loc - (dst_location - tgt_location) << " -> " << global_loc <<"\n";
         for (call_sitest::iterator it = call_info.get_call_sites().begin();
             it != call_info.get_call_sites().end(); ++it)
@@ -60,11 +62,11 @@ void subst_scenariot::initialize_call_info(
              if ((it->first)->location_number < dst_location &&
                  (it->first)->location_number > tgt_location)
                {
-                  (it->second).set_in_loop(true);   //"it" is inside the loop
+                  (it->second)->set_in_loop(true);   //"it" is inside the loop
                   // TODO: also, all nested function calls
                }
           }
-      } else {
+      } else if (record_locations) {
         goto_ranges_upwards.push_back(tgt_location);
       }
     }
@@ -75,10 +77,7 @@ void subst_scenariot::initialize_call_info(
       const irep_idt &target_function = to_symbol_expr(
         function_call.function()).get_identifier();
       // Mark the call site
-      call_tree_nodet& call_site = call_info.get_call_sites().insert(
-              std::pair<goto_programt::const_targett, call_tree_nodet>(inst,
-              call_tree_nodet(&call_info, global_loc)
-              )).first->second;
+      call_tree_nodet& call_site = get_call_site(call_info, inst, global_loc);
 
       functions.push_back(&call_site);
       call_site.set_preserved_node();
@@ -90,8 +89,15 @@ void subst_scenariot::initialize_call_info(
         call_site.set_recursion_nondet(true);
       } else if(!is_unwinding_exceeded(target_function)){
         increment_unwinding_counter(target_function);
-        initialize_call_info(call_site,
-                             this->get_goto_function(target_function).body);
+        if (lazy_expansion && !may_reach_assertion(target_function)) {
+          // only number the locations of the subtree, its nodes are created when needed
+          call_site.set_lazy(*this, global_loc);
+          skip_call_info(this->get_goto_function(target_function).body);
+        }
+        else {
+          initialize_call_info(call_site,
+                               this->get_goto_function(target_function).body);
+        }
       } else {
         call_site.set_unwind_exceeded(true);
         call_site.set_recursion_nondet(true);
@@ -110,10 +116,214 @@ void subst_scenariot::initialize_call_info(
     }
     else if (inst->type == ASSERT && !skip_asserts){
       call_info.get_assertions()[inst] = global_loc;
-      assertions_visited[inst][global_loc] = false;
+      if (record_locations) {
+        assertions_visited[inst][global_loc] = false;
+      }
+    }
+  }
+}
+
+/*******************************************************************\
+
+ Function: subst_scenariot::skip_call_info
+
+ Purpose: Walks the code (and the callees) as initialize_call_info does,
+ but without creating the call tree nodes; only the global locations
+ and the loop ranges are recorded. Used for the subtrees of lazy nodes,
+ which contain no assertions.
+
+\*******************************************************************/
+void subst_scenariot::skip_call_info(const goto_programt &code)
+{
+  for(goto_programt::const_targett inst=code.instructions.begin();
+      inst!=code.instructions.end(); ++inst)
+  {
+    global_loc++;
+    if (inst->type == GOTO)
+    {
+      unsigned dst_location = inst->location_number;
+      if(inst->targets.size()!=1)
+        throw "no support for non-deterministic goto (jump) instructions";
+
+      unsigned tgt_location = (*inst->targets.begin())->location_number;
+      if(tgt_location < dst_location){
+        if (record_locations) {
+          goto_ranges.push_back(std::make_pair(
+              global_loc - (dst_location - tgt_location),
+              global_loc));
+        }
+      } else if (record_locations) {
+        goto_ranges_upwards.push_back(tgt_location);
+      }
+    }
+    else if (inst->type == FUNCTION_CALL)
+    {
+      const code_function_callt& function_call = to_code_function_call(inst->code);
+      const irep_idt &target_function = to_symbol_expr(
+          function_call.function()).get_identifier();
+      if (!is_recursion_unwinding(target_function) && !is_unwinding_exceeded(target_function)) {
+        increment_unwinding_counter(target_function);
+        skip_call_info(this->get_goto_function(target_function).body);
+      }
+    }
+    else if (inst->type == END_FUNCTION){
+      const irep_idt &target_function = (inst->code).get("identifier");
+      decrement_unwinding_counter(target_function);
+    }
+    else if (inst->type == ASSERT) {
+      // may_reach_assertion decided that the subtree has no assertions
+      throw std::logic_error("Lazy call tree: an assertion found in the subtree of a lazy node (function "
+          + id2string(inst->function) + ")");
     }
   }
 }
+
+/*******************************************************************\
+
+ Function: subst_scenariot::expand
+
+ Purpose: Materializes the children of a lazy node by walking its body
+ again, starting from the same global location and with the unwinding
+ counters of its call stack (so that the locations are the same as if
+ the tree was built eagerly).
+
+\*******************************************************************/
+void subst_scenariot::expand(call_tree_nodet& node)
+{
+  assert(!node.is_root());
+  auto saved_loc = global_loc;
+  auto saved_record = record_locations;
+  reset_unwinding_counters();
+  for (call_tree_nodet* caller = &node; !caller->is_root(); caller = &caller->get_parent()) {
+    increment_unwinding_counter(caller->get_function_id());
+  }
+  global_loc = node.get_body_location();
+  record_locations = false;
+
+  initialize_call_info(node, this->get_goto_function(node.get_function_id()).body);
+
+  record_locations = saved_record;
+  global_loc = saved_loc;
+  reset_unwinding_counters();
+
+  // precision of the new nodes as if they were present when the precision was set up
+  if (precision_has_summary) {
+    node.set_initial_precision(default_precision, precision_has_summary, last_assertion_loc, precision_find_summary);
+  }
+}
+
+/*******************************************************************\
+
+ Function: subst_scenariot::may_reach_assertion
+
+ Purpose: Decides if the function or any function (transitively) called
+ from it contains an assertion; computed for all functions at once.
+
+\*******************************************************************/
+bool subst_scenariot::may_reach_assertion(const irep_idt & function_id)
+{
+  if (reaches_assertion.empty()) {
+    std::unordered_map<irep_idt, std::vector<irep_idt>, irep_id_hash> callees;
+    for (const auto & entry : goto_functions.function_map) {
+      bool has_assertion = false;
+      for (const auto & inst : entry.second.body.instructions) {
+        if (inst.type == ASSERT) {
+          has_assertion = true;
+        }
+        else if (inst.type == FUNCTION_CALL) {
+          const code_function_callt& function_call = to_code_function_call(inst.code);
+          callees[entry.first].push_back(to_symbol_expr(function_call.function()).get_identifier());
+        }
+      }
+      reaches_assertion[entry.first] = has_assertion;
+    }
+    // propagate to the callers until the fixpoint
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto & entry : reaches_assertion) {
+        if (entry.second) { continue; }
+        for (const auto & callee : callees[entry.first]) {
+          auto it = reaches_assertion.find(callee);
+          if (it != reaches_assertion.end() && it->second) {
+            entry.second = true;
+            changed = true;
+            break;
+          }
+        }
+      }
+    }
+  }
+  auto it = reaches_assertion.find(function_id);
+  return it == reaches_assertion.end() || it->second;
+}
+
+/*******************************************************************\
+
+ Function: subst_scenariot::get_call_site
+
+ Purpose: Returns the child of the node for the given call instruction,
+ a new node is taken from the pool if there is none yet.
+
+\*******************************************************************/
+call_tree_nodet& subst_scenariot::get_call_site(
+        call_tree_nodet& parent, goto_programt::const_targett target, unsigned location)
+{
+  call_tree_nodet* existing = parent.find_call_site(target);
+  if (existing) {
+    return *existing;
+  }
+  node_pool.emplace_back(&parent, location);
+  call_tree_nodet& node = node_pool.back();
+  parent.add_call_site(target, node);
+  // the node is appended to functions, which is then no longer in DFS order
+  // if the node was created after its parent's subtree (expansion, cloning)
+  functions_in_dfs_order = false;
+  return node;
+}
+
+/*******************************************************************\
+
+ Function: subst_scenariot::restore_dfs_order
+
+ Purpose: Rebuilds functions in DFS order (the order of the eager
+ construction, which serialize and restore_call_info rely on).
+
+\*******************************************************************/
+void subst_scenariot::restore_dfs_order()
+{
+  if (functions_in_dfs_order) {
+    return;
+  }
+  std::size_t size = functions.size();
+  functions.clear();
+  functions.reserve(size);
+  collect_functions(functions_root);
+  assert(functions.size() == size);
+  functions_in_dfs_order = true;
+}
+
+void subst_scenariot::collect_functions(call_tree_nodet& node)
+{
+  // the call sites are sorted by the call instruction
+  for (auto & call_site : node.get_call_sites()) {
+    functions.push_back(call_site.second);
+    collect_functions(*call_site.second);
+  }
+}
+
+// The number of the enclosing calls of the same function
+static unsigned recursion_depth(const call_tree_nodet& call)
+{
+  unsigned depth = 0;
+  for (const call_tree_nodet* node = &call; !node->is_root(); node = &node->get_parent()){
+    if (node->get_parent().get_function_id() == call.get_function_id()){
+      depth++;
+    }
+  }
+  return depth;
+}
+
 /*******************************************************************\
  
  Function:
@@ -125,13 +335,9 @@ void subst_scenariot::clone_children(call_tree_nodet& call, call_tree_nodet& par
   for (call_sitest::iterator it = parent.get_call_sites().begin();
           it != parent.get_call_sites().end(); ++it)
   {
-    call_tree_nodet& to_be_cloned = it->second;
+    call_tree_nodet& to_be_cloned = *it->second;
 //    call.set_unwind_exceeded(false);
-    call_tree_nodet& cloned = call.get_call_sites().insert(
-            std::pair<goto_programt::const_targett, call_tree_nodet>(
-            *to_be_cloned.get_target(),
-            call_tree_nodet(&call, to_be_cloned.get_call_location())
-            )).first->second;
+    call_tree_nodet& cloned = get_call_site(call, it->first, to_be_cloned.get_call_location());
     functions.push_back(&cloned);
     cloned.set_function_id(to_be_cloned.get_function_id());
     cloned.set_preserved_node();
@@ -147,6 +353,11 @@ void subst_scenariot::clone_children(call_tree_nodet& call, call_tree_nodet& par
         cloned.set_nondet();
       }
     }
+    else if (!to_be_cloned.is_expanded()) {
+      // the clone is expanded on demand as well
+      cloned.set_lazy(*this, to_be_cloned.get_body_location());
+      cloned.set_precision(to_be_cloned.get_precision());
+    }
     else {
       cloned.set_precision(to_be_cloned.get_precision());
       clone_children(cloned, to_be_cloned);
@@ -162,10 +373,37 @@ void subst_scenariot::refine_recursion_call(call_tree_nodet& call)
   } while
     (parent->get_function_id() != call.get_function_id());
 
+  if (unwind_bounds) {
+    unwind_bounds->recursion_unwound(id2string(call.get_function_id()), recursion_depth(call));
+  }
   // clone all children
   clone_children(call, *parent);
 }
 
+/*******************************************************************\
+
+ Function: subst_scenariot::unwind_known_recursion
+
+ Purpose: Unwinds the recursive calls up to the depths found by the
+ refinement before, instead of finding them again
+
+\*******************************************************************/
+void subst_scenariot::unwind_known_recursion()
+{
+  // the unwinding appends the new nodes, they are visited as well
+  for (std::size_t i = 0; i < functions.size(); i++){
+    call_tree_nodet& call = *functions[i];
+    if (!call.is_recursion_nondet() || call.get_precision() != HAVOC
+        || recursion_depth(call) > unwind_bounds->get_recursion_depth(id2string(call.get_function_id()))) {
+      continue;
+    }
+    if (call.get_call_sites().empty()){
+      refine_recursion_call(call);
+    }
+    call.set_inline();
+  }
+}
+
 unsigned subst_scenariot::get_precision_count(summary_precisiont precision)
 {
   unsigned count = 0;
@@ -184,10 +422,10 @@ unsigned subst_scenariot::get_precision_count(call_tree_nodet& summary, summary_
     for (call_sitest::iterator it = summary.get_call_sites().begin();
             it != summary.get_call_sites().end(); ++it)
     {
-      if ((it->second).get_precision() == precision){
+      if ((it->second)->get_precision() == precision){
         res++;
       }
-      res += get_precision_count(it->second, precision);
+      res += get_precision_count(*it->second, precision);
     }
   }
   return res;
@@ -428,6 +666,7 @@ void subst_scenariot::serialize(const std::string& file)
     return;
   }
 
+  restore_dfs_order();
   for (unsigned i = 0; i < functions.size(); i++) {
     const call_tree_nodet& info = *functions[i];
     out << info.get_function_id() << std::endl;
@@ -496,11 +735,8 @@ void subst_scenariot::restore_call_info(
 
     if (inst->type == FUNCTION_CALL)
     {
-        //insert a pair of goto_programt and call_tree_node into map (call_site)
-        call_tree_nodet& call_site = call_info.get_call_sites().insert(
-              std::pair<goto_programt::const_targett, call_tree_nodet>
-                      (inst,call_tree_nodet(&call_info, global_loc))
-                      ).first->second;
+        //get (or create) the node of the call site
+        call_tree_nodet& call_site = get_call_site(call_info, inst, global_loc);
 
         functions.push_back(&call_site);
     
@@ -554,6 +790,7 @@ void subst_scenariot::get_unwinding_depth()
 {
   rec_count_max = 0;
   rec_count_total = 0;
+  restore_dfs_order();
   unsigned i;
   for (i = functions.size() - 1; i > 0; i--){
     if ((*functions[i]).is_recursion_nondet() && (*functions[i]).get_precision() == HAVOC){
@@ -12,12 +12,16 @@
 #define CPROVER_SUBST_SCENARIO_H
 
 #include <map>
+#include <deque>
+#include <functional>
+#include <unordered_map>
 #include <goto-programs/goto_program.h>
 #include <goto-programs/goto_functions.h>
 #include <util/xml.h>
 
 #include "call_tree_node.h"
 #include "unwind.h"
+#include "unwind_bounds.h"
 
 class call_tree_nodet;
 
@@ -27,7 +31,7 @@ enum class init_modet {
     // anything else?
 };
 
-class subst_scenariot:public unwindt {
+class subst_scenariot:public unwindt, private call_tree_expandert {
 public:
   subst_scenariot(
       const goto_functionst &goto_functions, unsigned int max_unwind):
@@ -35,9 +39,19 @@ public:
         functions_root (nullptr, 0),
         default_precision (INLINE),
         global_loc (0),
+        lazy_expansion (false),
+        record_locations (true),
         goto_functions {goto_functions}
   {};
 
+  // Lazy call tree: subtrees without assertions are materialized only
+  // when their root gets inlined (must be set before initialize_call_info)
+  void set_lazy_expansion(bool lazy) { lazy_expansion = lazy; }
+
+  // Recursion depths of the automatic unwinding: the refined ones are recorded,
+  // the known ones are unwound when setting the initial precision
+  void set_unwind_bounds(unwind_boundst* bounds) { unwind_bounds = bounds; }
+
   call_tree_nodet& get_call_tree_root(){ return functions_root; };
 
   void get_unwinding_depth();
@@ -46,7 +60,7 @@ public:
 
   void process_goto_locations();
   void setup_default_precision(init_modet init);
-  std::vector<call_tree_nodet*>& get_call_summaries() { return functions; }
+  std::vector<call_tree_nodet*>& get_call_summaries() { restore_dfs_order(); return functions; }
   unsigned get_summaries_count() { return get_precision_count(SUMMARY); }
   unsigned get_nondets_count() { return get_precision_count(HAVOC); }
 
@@ -57,11 +71,18 @@ public:
           (call_tree_nodet &call_info, const goto_programt &code);
 
   void set_initial_precision
-          (const assertion_infot & assertion, const std::function<bool(const std::string &)> & has_summary)
+          (const assertion_infot & assertion, const std::function<bool(const std::string &)> & has_summary,
+           const std::function<summary_idt(const call_tree_nodet &)> & find_summary = nullptr)
   {
       setup_last_assertion_loc(assertion);
       assert(functions_root.is_root());
-      functions_root.set_initial_precision(default_precision, has_summary, last_assertion_loc);
+      // kept for the nodes materialized later (lazy call tree), the predicates must stay valid during the check
+      precision_has_summary = has_summary;
+      precision_find_summary = find_summary;
+      functions_root.set_initial_precision(default_precision, has_summary, last_assertion_loc, find_summary);
+      if (unwind_bounds) {
+          unwind_known_recursion();
+      }
   }
 
   void serialize(const std::string& file);
@@ -105,7 +126,14 @@ private:
   summary_precisiont default_precision;
   location_visitedt assertions_visited;
 
+  // Owns all the nodes of the call tree except the root (addresses are stable)
+  std::deque<call_tree_nodet> node_pool;
+
+  // All the nodes in DFS order (the order of the omega file); the nodes
+  // materialized later (lazy expansion, recursion) are appended and the
+  // order is restored when the vector is read
   std::vector<call_tree_nodet*> functions;
+  bool functions_in_dfs_order {true};
   std::vector<std::pair<unsigned, unsigned> > goto_ranges;
   std::vector<unsigned> goto_ranges_upwards;
   unsigned global_loc;
@@ -115,10 +143,28 @@ private:
   unsigned rec_count_max;
   unsigned rec_count_total;
 
+  bool lazy_expansion;
+  unwind_boundst* unwind_bounds {nullptr};
+  // false when re-walking an already numbered part of the program (expansion of a lazy node)
+  bool record_locations;
+  // functions whose body (or a callee, transitively) contains an assertion
+  std::unordered_map<irep_idt, bool, irep_id_hash> reaches_assertion;
+  std::function<bool(const std::string &)> precision_has_summary;
+  std::function<summary_idt(const call_tree_nodet &)> precision_find_summary;
+
   const goto_functionst & goto_functions;
 
   const goto_functionst::goto_functiont& get_goto_function(irep_idt fun) const;
 
+  call_tree_nodet& get_call_site(call_tree_nodet& parent, goto_programt::const_targett target, unsigned location);
+
+  void expand(call_tree_nodet& node) override;
+  void skip_call_info(const goto_programt &code);
+  void restore_dfs_order();
+  void collect_functions(call_tree_nodet& node);
+  void unwind_known_recursion();
+  bool may_reach_assertion(const irep_idt & function_id);
+
   unsigned get_precision_count(summary_precisiont precision);
   unsigned get_precision_count(call_tree_nodet& summary, summary_precisiont precision);
 
@@ -7,6 +7,7 @@ Module: Storage class for function summaries (union-find).
 #include "summary_store.h"
 #include "call_tree_node.h"
 #include <algorithm>
+#include <stdexcept>
 #include <utility>
 
 const summary_storet::nodet& summary_storet::find_repr(summary_idt id) const
@@ -60,10 +61,18 @@ Function: summary_storet::replace_summary
  */
 std::size_t summary_storet::get_next_id(const std::string &fname)
 {
+  check_writable();
   // uses the fact that if the key was not in the map, it is implicitly inserted with default value -> 0
   return next_ids[fname]++;
 }
 
+void summary_storet::check_writable() const
+{
+  if (read_only) {
+    throw std::logic_error{"Trying to change the summary store while it is read only"};
+  }
+}
+
 /*******************************************************************\
 
 Function: summary_storet::find_summary
@@ -90,6 +99,7 @@ Function: summary_storet::insert_summary
  Note that summary store takes ownership of the pointer; the passed pointer cannot be used anymore!
 \*******************************************************************/
 summary_idt summary_storet::insert_summary(itpt_summaryt * summary_given, const std::string & fname_countered) {
+    check_writable();
     // Do not add summary if the same ID is already there
     if(function_has_summaries(fname_countered)) {
         const auto & summaries = get_summariesID(fname_countered);
@@ -134,4 +144,54 @@ void summary_storet::serialize(std::string file_name) {
 \*******************************************************************/
 bool summary_storet::node_has_summaries(const call_tree_nodet* node) {
     return node->get_node_sumID() != 0;
-}
\ No newline at end of file
+}
+
+/*******************************************************************
+ Purpose: context-aware summary cache; remember where the summary
+ was computed, so that it can be reused at other call sites
+\*******************************************************************/
+void summary_storet::register_summary_context(summary_idt id, const std::string & function_name,
+                                              std::size_t signature, std::size_t context) {
+    check_writable();
+    auto & contexts = fname_to_contexts[function_name];
+    auto it = std::find_if(contexts.begin(), contexts.end(), [id](const summary_contextt & ctx) { return ctx.id == id; });
+    if (it == contexts.end()) {
+        contexts.push_back(summary_contextt{id, signature, context});
+    }
+}
+
+/*******************************************************************
+ Purpose: every summary over-approximates the function in any context,
+ but only a summary computed at a call site of the same signature is
+ likely precise enough there; the calling context decides among them.
+ Summaries not registered with a call site (e.g., read from a file) are
+ used at every call site that has no summary of a compatible one.
+\*******************************************************************/
+summary_idt summary_storet::find_context_summary(const std::string & function_name, std::size_t signature,
+                                                 std::size_t context) const {
+    auto ctx_it = fname_to_contexts.find(function_name);
+    if (ctx_it != fname_to_contexts.end()) {
+        summary_idt same_signature = 0;
+        // the latest summaries are the strongest ones, search backwards
+        for (auto it = ctx_it->second.rbegin(); it != ctx_it->second.rend(); ++it) {
+            if (it->signature != signature) { continue; }
+            if (it->context == context) { return it->id; }
+            if (same_signature == 0) { same_signature = it->id; }
+        }
+        if (same_signature != 0) {
+            return same_signature;
+        }
+    }
+    auto ids_it = fname_to_summaryIDs.find(function_name);
+    if (ids_it == fname_to_summaryIDs.end()) {
+        return 0;
+    }
+    for (auto it = ids_it->second.rbegin(); it != ids_it->second.rend(); ++it) {
+        summary_idt id = *it;
+        bool registered = ctx_it != fname_to_contexts.end()
+            && std::any_of(ctx_it->second.begin(), ctx_it->second.end(),
+                           [id](const summary_contextt & ctx) { return ctx.id == id; });
+        if (!registered) { return id; }
+    }
+    return 0;
+}
@@ -47,7 +47,21 @@ public:
   std::size_t get_next_id(const std::string &fname);
   
   // Reset the summary store
-  void clear() { store.clear(); max_id = 1; repr_count = 0; fname_to_summaryIDs.clear();}
+  void clear() {
+      check_writable();
+      store.clear(); max_id = 1; repr_count = 0; fname_to_summaryIDs.clear();
+      fname_to_contexts.clear();
+  }
+
+  // Remembers the interface signature and the calling context of the call site the summary was computed at
+  void register_summary_context(summary_idt id, const std::string & function_name,
+                                std::size_t signature, std::size_t context);
+
+  // Finds a summary of the function computed at a compatible call site (the same call site signature),
+  // preferring the same calling context; otherwise the latest summary not registered with any call site
+  // (e.g., loaded from a file); returns 0 if there is no such summary
+  summary_idt find_context_summary(const std::string & function_name, std::size_t signature,
+                                   std::size_t context) const;
 
 
   bool function_has_summaries(const std::string & function_name) const {
@@ -56,6 +70,11 @@ public:
       return it != fname_to_summaryIDs.end() && !it->second.empty();
   }
   
+  // A read-only store throws std::logic_error on every change; it is read only while
+  // another thread reads it (the streaming conversion, see partitioning_target_equationt)
+  void set_read_only(bool read_only) { this->read_only = read_only; }
+  bool is_read_only() const { return read_only; }
+
   //usage in UpProver
     bool node_has_summaries(const call_tree_nodet* node);
     
@@ -70,6 +89,7 @@ public:
   
   // Removes summary from the summary store
   void remove_summary(const summary_idt id){
+      check_writable();
       //for statistics
       deleted_sumIDs.insert(id);
       
@@ -104,6 +124,13 @@ public:
       if (generated_sumIDs.find(id) != generated_sumIDs.end()){
           generated_sumIDs.erase(id);
       }
+      //5- delete from the context cache
+      for (auto & entry : fname_to_contexts) {
+          auto & contexts = entry.second;
+          contexts.erase(std::remove_if(contexts.begin(), contexts.end(),
+                                        [id](const summary_contextt & ctx) { return ctx.id == id; }),
+                         contexts.end());
+      }
   }
     //[statistics] counts total number of generated summaries in UpProver
     std::unordered_set<summary_idt> generated_sumIDs;
@@ -139,6 +166,9 @@ protected:
 
   const nodet& find_repr(summary_idt id) const;
 
+  void check_writable() const;
+  bool read_only {false};
+
   // Maximal used id
   summary_idt max_id;
   summary_idt repr_count;
@@ -148,6 +178,14 @@ protected:
 
   std::unordered_map<std::string, summary_ids_vect> fname_to_summaryIDs;
   std::unordered_map<summary_idt, itpt_summaryt*> id_to_summary;
+
+  // Context-aware cache: for each function the call sites (signature, calling context) the summaries were computed at
+  struct summary_contextt {
+    summary_idt id;
+    std::size_t signature;
+    std::size_t context;
+  };
+  std::unordered_map<std::string, std::vector<summary_contextt>> fname_to_contexts;
   //std::unordered_map<call_tree_nodet*, summary_idt> node_to_summaryID; //no-need! sumID is attribute of call-tree-node from now on.
 };
 
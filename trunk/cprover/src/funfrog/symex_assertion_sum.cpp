@@ -13,9 +13,13 @@
 #include <util/base_type.h>
 #include <langapi/language_util.h>
 #include <goto-instrument/accelerate/acceleration_utils.h>
+#include <analyses/dirty.h>
+#include <util/prefix.h>
+#include <util/cprover_prefix.h>
 
 #include "partition_iface.h"
 #include "call_tree_node.h"
+#include "interval_invariants.h"
 #include "utils/naming_helpers.h"
 #include "partitioning_target_equation.h"
 #include "assertion_info.h"
@@ -69,6 +73,9 @@ symex_assertion_sumt::symex_assertion_sumt(
 	  max_unwind(_max_unwind)
 {
 	analyze_globals();
+	if (_options.get_bool_option("reduce-iface")) {
+		reduce_modified_globals();
+	}
 }
 
 /*******************************************************************
@@ -227,7 +234,7 @@ bool symex_assertion_sumt::process_planned(statet & state)
   log.statistics() << "SYMEX TIME: " << time_gap(after,before) << log.eom;
 
 #ifdef DEBUG_SSA
-    print_SSA_steps(equation.SSA_steps, ns, std::cout);
+    print_SSA_steps(equation.get_SSA_steps(), ns, std::cout);
 #endif //DEBUG_SSA
 
   return false; //
@@ -275,7 +282,11 @@ void symex_assertion_sumt::symex_step(
 
   const goto_programt::instructiont &instruction = *state.source.pc;
   loc++;
+  const bool merge_point = state.top().goto_state_map.count(state.source.pc) != 0;
   merge_gotos(state);
+  if (merge_point) {
+    release_change_log(state);
+  }
     
   // actually do instruction
   //the "reachable" flag is set false whenever an unwind/depth
@@ -664,6 +675,9 @@ void symex_assertion_sumt::assign_function_arguments(
   // find code in function map
   const goto_functionst::goto_functiont &goto_function = get_function(identifier);
 
+  // Remember the constant actuals before the propagation is stopped for the interface
+  mark_argument_values(state, goto_function.type, function_call.arguments(), partition_iface);
+
   // Add parameters assignment
   bool old_cp = symex_config.constant_propagation;
   //stop constant propagation
@@ -771,6 +785,56 @@ void symex_assertion_sumt::mark_accessed_global_symbols(const irep_idt & functio
   }
 }
 
+/*******************************************************************
+
+ Function: symex_assertion_sumt::mark_argument_values
+
+ Purpose: Stores the values of the arguments and accessed globals that are
+ known at the call site (constant propagation) to the partition interface,
+ in the same order as the symbols in argument_symbols. Unknown values are nil.
+
+ Note: Must be called before the interface symbols are marked, since marking
+ stops the constant propagation for the globals.
+
+\*******************************************************************/
+void symex_assertion_sumt::mark_argument_values(
+    statet & state,
+    const code_typet & function_type,
+    const exprt::operandst & arguments,
+    partition_ifacet & partition_iface)
+{
+  auto known_constant = [](const exprt & value) -> exprt {
+    // pointer constants are not supported in summaries
+    if (value.is_constant() && value.type().id() != ID_pointer) {
+      return value;
+    }
+    return nil_exprt();
+  };
+
+  const auto & parameters = function_type.parameters();
+  for (std::size_t i = 0; i < parameters.size(); ++i) {
+    if (i >= arguments.size()) {
+      partition_iface.argument_values.push_back(nil_exprt());
+      continue;
+    }
+    exprt value = arguments[i];
+    if (!base_type_eq(value.type(), parameters[i].type(), ns)) {
+      value = typecast_exprt(value, parameters[i].type());
+    }
+    state.rename(value, ns);
+    do_simplify(value);
+    partition_iface.argument_values.push_back(known_constant(value));
+  }
+
+  for (auto global_id : get_accessed_globals(partition_iface.function_id)) {
+    const auto & symbol = get_normal_symbol(global_id);
+    const statet::propagationt & propagation = state.propagation;
+    auto found = propagation.find(get_l1_identifier(symbol));
+    partition_iface.argument_values.push_back(
+        found.second ? known_constant(found.first) : nil_exprt());
+  }
+}
+
 /*******************************************************************
 
  Function: symex_assertion_sumt::modified_globals_assignment_and_mark
@@ -950,8 +1014,7 @@ void symex_assertion_sumt::clear_locals_versions(statet &state)
 #endif
         // FIXME: MB: test if this behaviour is correct
 
-        auto it2 = state.level2.current_names.find(local_id);
-        if(it2 != state.level2.current_names.end())
+        if(state.level2.has_name(local_id))
             state.level2.current_names[local_id].first.remove_level_2();
 
         //commented 5.12
@@ -980,8 +1043,9 @@ void symex_assertion_sumt::handle_function_call(
   // What are we supposed to do with this precise function call? 
 
   // get call_tree_node corresponding to the called function
-  call_tree_nodet &call_tree_node = current_call_tree_node->get_call_sites().find(
-      state.source.pc)->second;
+  call_tree_nodet * call_tree_node_ptr = current_call_tree_node->find_call_site(state.source.pc);
+  assert(call_tree_node_ptr);
+  call_tree_nodet &call_tree_node = *call_tree_node_ptr;
   assert(get_current_deferred_function().partition_iface.partition_id != NO_PARTITION_ID);
 
   // Clean expressions in the arguments, function name, and lhs (if any)
@@ -999,6 +1063,14 @@ void symex_assertion_sumt::handle_function_call(
   const irep_idt& function_id = function_call.function().get(ID_identifier);
   const goto_functionst::goto_functiont &goto_function = get_function(function_id);
 
+  // No execution reaches the call, no partition needed
+  if (invariants && !invariants->is_reachable(state.source.pc)) {
+    log.statistics() << "*** UNREACHABLE call pruned: " << function_id.c_str() << log.eom;
+    loc = call_tree_node.get_call_location();
+    target.assumption(state.guard.as_expr(), false_exprt(), state.source);
+    return;
+  }
+
   // Do we have the body?
   if(!goto_function.body_available())
   {
@@ -1031,6 +1103,14 @@ void symex_assertion_sumt::handle_function_call(
   // Assign function parameters and return value
   assign_function_arguments(state, function_call, deferred_function.partition_iface);
 
+  // The invariants hold for this program only; the summaries of the caller depend on them and are not saved
+  if (invariants) {
+    exprt entry_invariant = invariants->entry_invariant(state.source.pc, deferred_function.partition_iface);
+    if (!entry_invariant.is_true()) {
+      target.assumption(state.guard.as_expr(), entry_invariant, state.source);
+    }
+  }
+
   // KE: need it for both cases, when we have the function, and when we don't have it
   bool is_deferred_func = (call_tree_node.get_call_location() < last_assertion_loc) ||
                           ((is_unwind_loop(state) || get_current_deferred_function().call_tree_node.is_in_loop())
@@ -1050,6 +1130,14 @@ void symex_assertion_sumt::handle_function_call(
       assert(false);
       break;
     }
+    // Cheap candidate summary of the abstracted body
+    if (invariants && call_tree_node.get_precision() != INLINE) {
+      exprt exit_invariant = invariants->exit_invariant(deferred_function.partition_iface);
+      if (!exit_invariant.is_true()) {
+        log.statistics() << "Interval invariant used at the return of: " << function_id.c_str() << log.eom;
+        target.assumption(state.guard.as_expr(), exit_invariant, state.source);
+      }
+    }
   }
 }
 
@@ -1073,6 +1161,11 @@ void symex_assertion_sumt::summarize_function_call(
   produce_callend_assumption(partition_iface, state);
 
   log.statistics() << "Substituting interpolant" << log.eom;
+  auto known_values = std::count_if(partition_iface.argument_values.begin(), partition_iface.argument_values.end(),
+                                    [](const exprt & value) { return value.is_not_nil(); });
+  if (known_values > 0) {
+    log.statistics() << "Specializing summary to " << known_values << " constant argument(s)" << log.eom;
+  }
 
   partition_idt partition_id = equation.reserve_partition(partition_iface);
   
@@ -1234,6 +1327,28 @@ void symex_assertion_sumt::raw_assignment(
 
 /*******************************************************************\
 
+Function: symex_assertion_sumt::release_change_log
+
+ Purpose: The log of the changed level2 entries is only read by
+ phi_function from the positions saved in the pending branches; once
+ every branch (in any frame on the call stack) has been merged, nobody
+ reads it and it can be cleared.
+\*******************************************************************/
+void symex_assertion_sumt::release_change_log(statet &state)
+{
+  if (state.level2.change_log.empty()) {
+    return;
+  }
+  for (const auto & frame : state.call_stack()) {
+    if (!frame.goto_state_map.empty()) {
+      return;
+    }
+  }
+  state.level2.change_log.clear();
+}
+
+/*******************************************************************\
+
 Function: symex_assertion_sumt::phi_function
 
  Purpose: Modification of the goto_symext version. In contrast, we
@@ -1247,9 +1362,35 @@ void symex_assertion_sumt::phi_function(
 {
   // go over all variables to see what changed
   std::unordered_set<ssa_exprt, irep_hash> variables;
+  const symex_level2t::current_namest & dest_names = dest_state.level2.current_names;
+  const statet::propagationt & dest_propagation = dest_state.propagation;
   
-  goto_state.level2_get_variables(variables);
-  dest_state.level2.get_variables(variables);
+  if(dest_state.level2.record_changes)
+  {
+    // goto_state is a snapshot of dest_state taken at the branch, so only
+    // the entries changed after that (the tail of the log) can differ
+    const auto & change_log = dest_state.level2.change_log;
+    assert(goto_state.level2_log_size <= change_log.size());
+    std::unordered_set<irep_idt, irep_id_hash> changed(
+        change_log.begin() + goto_state.level2_log_size, change_log.end());
+    for(const irep_idt & l1_identifier : changed)
+    {
+      auto goto_found = goto_state.level2_current_names.find(l1_identifier);
+      if(goto_found.second)
+        variables.insert(goto_found.first.first);
+      auto dest_found = dest_names.find(l1_identifier);
+      if(dest_found.second)
+        variables.insert(dest_found.first.first);
+    }
+  }
+  else
+  {
+    // otherwise only the subtrees not shared by the two maps can differ
+    std::vector<std::tuple<ssa_exprt, unsigned, unsigned>> delta;
+    symex_level2t::get_delta(goto_state.level2_current_names, dest_names, delta);
+    for(const auto & item : delta)
+      variables.insert(std::get<0>(item));
+  }
   
   guardt diff_guard;
   
@@ -1300,21 +1441,20 @@ void symex_assertion_sumt::phi_function(
     exprt dest_state_rhs = variable;
     
     {
-      auto p_it= goto_state.propagation.find(l1_identifier);
+      auto p_found = goto_state.propagation.find(l1_identifier);
       
-      if(p_it!=goto_state.propagation.end())
-        goto_state_rhs=p_it->second;
+      if(p_found.second)
+        goto_state_rhs=p_found.first;
       else
         to_ssa_expr(goto_state_rhs).set_level_2(
             goto_state.level2_current_count(l1_identifier));
     }
     
     {
-      auto p_it=
-          dest_state.propagation.find(l1_identifier);
+      auto p_found = dest_propagation.find(l1_identifier);
       
-      if(p_it!=dest_state.propagation.end())
-        dest_state_rhs=p_it->second;
+      if(p_found.second)
+        dest_state_rhs=p_found.first;
       else
         to_ssa_expr(dest_state_rhs).set_level_2(
             dest_state.level2.current_count(l1_identifier));
@@ -1347,6 +1487,24 @@ void symex_assertion_sumt::phi_function(
         symex_targett::assignment_typet::PHI);
   }
 }
+/*******************************************************************\
+ 
+ Purpose: the unwind bound cuts the loop (by an assumption, unless
+ partial loops are allowed); remember it for the iterative deepening and the
+ automatic unwinding
+ 
+\*******************************************************************/
+void symex_assertion_sumt::loop_bound_exceeded(statet &state, const exprt &guard)
+{
+  if (!state.guard.is_false()) {
+    loop_bound_reached = true;
+    if (unwind_bounds) {
+      unwind_bounds->loop_bound_exceeded(id2string(state.source.pc->function), state.source.pc->source_location,
+                                         state.source.pc->loop_number);
+    }
+  }
+  goto_symext::loop_bound_exceeded(state, guard);
+}
 /*******************************************************************\
  
  Purpose: symex of verification condition (claim)
@@ -1497,7 +1655,7 @@ ssa_exprt symex_assertion_sumt::get_next_version(const symbolt & symbol) {
   //ssa_exprt ssa_l1 = get_l1_ssa(symbol);
   irep_idt ssa_l1_identifier = get_l1_identifier(symbol); //e.g: "hifrog::fun_start!0"
 //  //safety
-  assert(state->level2.current_names.find(ssa_l1_identifier) != state->level2.current_names.end());
+  assert(state->level2.has_name(ssa_l1_identifier));
   
   // get the current L1 version of the symbol //5.10
   state->level2.increase_counter(ssa_l1_identifier);
@@ -1565,7 +1723,7 @@ void symex_assertion_sumt::create_new_artificial_symbol(const irep_idt & id, con
   // register the l1 version of the symbol to enable asking for current L2 version
   ssa_exprt l1_ssa = get_l1_ssa(symbol);
   auto l1_id = l1_ssa.get_l1_object_identifier();
-  assert(state->level2.current_names.find(l1_id) == state->level2.current_names.end());
+  assert(!state->level2.has_name(l1_id));
   // MB: it seems the CPROVER puts L1 ssa expression as the first of the pair, so we do the same, but I fail to see the reason
   state->level2.current_names[l1_id] = std::make_pair(l1_ssa,0);
 
@@ -1681,7 +1839,7 @@ void symex_assertion_sumt::add_globals_to_state(statet & state)
     const auto & l1_identifier = ssa.get_identifier();
     state.rename(ssa.type(), l1_identifier, ns);
     ssa.update_type();
-    assert(state.level2.current_names.find(l1_identifier) == state.level2.current_names.end());
+    assert(!state.level2.has_name(l1_identifier));
     state.level2.current_names[l1_identifier] = std::make_pair(ssa, 0);
 //    const auto p_it = state.level2.current_names.find(l1_identifier);
 //    assert(!p_it);
@@ -1758,6 +1916,138 @@ void symex_assertion_sumt::analyze_globals_rec(irep_idt function_to_analyze,
             std::back_inserter(modified));
 }
 
+/*******************************************************************\
+ Purpose: Liveness-based reduction of the output interfaces. A modified
+ global stays an out symbol of a function only if it may be read after
+ some call of the function returns. Liveness is a backward analysis over
+ the body of each function (a plain assignment kills the global, a call
+ reads everything the callee accesses); the globals live at the end of a
+ function are those live after any of its call sites, so the functions
+ are re-analysed until these sets are stable. Globals whose address is
+ taken and CPROVER internals are always kept. The input interfaces are
+ left untouched; the reduction does not depend on the call site, so all
+ summaries of a function keep the same shape.
+\*******************************************************************/
+void symex_assertion_sumt::reduce_modified_globals()
+{
+  const dirtyt address_taken(goto_functions);
+  // globals live after some call of the given function returns
+  std::unordered_map<irep_idt, irep_lex_set, irep_id_hash> live_after_call;
+
+  std::vector<irep_idt> worklist;
+  for (const auto & entry : goto_functions.function_map) {
+    if (entry.second.body_available()) {
+      worklist.push_back(entry.first);
+    }
+  }
+
+  while (!worklist.empty()) {
+    const irep_idt function_id = worklist.back();
+    worklist.pop_back();
+    const auto & body = goto_functions.function_map.at(function_id).body;
+    const irep_lex_set & live_at_exit = live_after_call[function_id];
+
+    std::vector<goto_programt::const_targett> targets;
+    std::unordered_map<const goto_programt::instructiont *, std::size_t> index_of;
+    for (auto it = body.instructions.begin(); it != body.instructions.end(); ++it) {
+      index_of[&*it] = targets.size();
+      targets.push_back(it);
+    }
+
+    std::vector<irep_lex_set> gen(targets.size());
+    std::vector<irep_lex_set> kill(targets.size());
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+      const auto & inst = *targets[i];
+      for (const auto & expr : objects_read(inst)) {
+        add_to_set_if_global(ns, expr, gen[i]);
+      }
+      for (const auto & expr : objects_written(inst)) {
+        if (expr.id() == ID_symbol) {
+          const symbolt & symbol = ns.lookup(to_symbol_expr(expr).get_identifier());
+          if (symbol.is_static_lifetime) {
+            kill[i].insert(symbol.name);
+          }
+        } else {
+          // partial update, the rest of the object is still read
+          add_to_set_if_global(ns, expr, gen[i]);
+        }
+      }
+      if (inst.type == FUNCTION_CALL) {
+        const irep_idt & callee = to_symbol_expr(
+            to_code_function_call(inst.code).function()).get_identifier();
+        const auto & callee_globals = get_accessed_globals(callee);
+        gen[i].insert(callee_globals.begin(), callee_globals.end());
+      }
+    }
+
+    auto live_out = [&](const std::vector<irep_lex_set> & live, std::size_t i) {
+      const auto successors = body.get_successors(targets[i]);
+      if (successors.empty()) {
+        return live_at_exit;
+      }
+      irep_lex_set out;
+      for (const auto & succ : successors) {
+        const auto & succ_live = live[index_of.at(&*succ)];
+        out.insert(succ_live.begin(), succ_live.end());
+      }
+      return out;
+    };
+
+    std::vector<irep_lex_set> live(targets.size());
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (std::size_t i = targets.size(); i-- > 0;) {
+        irep_lex_set in = live_out(live, i);
+        for (const auto & killed : kill[i]) {
+          in.erase(killed);
+        }
+        in.insert(gen[i].begin(), gen[i].end());
+        // the sets only grow
+        if (in.size() != live[i].size()) {
+          live[i] = std::move(in);
+          changed = true;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+      if (targets[i]->type != FUNCTION_CALL) {
+        continue;
+      }
+      const irep_idt & callee = to_symbol_expr(
+          to_code_function_call(targets[i]->code).function()).get_identifier();
+      const auto & out = live_out(live, i);
+      auto & callee_live = live_after_call[callee];
+      const auto old_size = callee_live.size();
+      callee_live.insert(out.begin(), out.end());
+      if (callee_live.size() != old_size
+          && goto_functions.function_map.at(callee).body_available()
+          && std::find(worklist.begin(), worklist.end(), callee) == worklist.end()) {
+        worklist.push_back(callee);
+      }
+    }
+  }
+
+  std::size_t total = 0;
+  std::size_t dropped = 0;
+  for (auto & entry : modified_globals) {
+    const auto & live = live_after_call[entry.first];
+    auto & modified = entry.second;
+    total += modified.size();
+    auto new_end = std::remove_if(modified.begin(), modified.end(),
+      [&](const irep_idt & global_id) {
+        return live.find(global_id) == live.end()
+               && !address_taken(global_id)
+               && !has_prefix(id2string(global_id), CPROVER_PREFIX);
+      });
+    dropped += std::distance(new_end, modified.end());
+    modified.erase(new_end, modified.end());
+  }
+  log.statistics() << "Interface reduction: " << dropped << " of " << total
+                   << " modified globals dead after the calls" << log.eom;
+}
+
 /*******************************************************************\
 Purpose: Upprover/HiFrog needs the return assignment for the summaries.
  The idea is to add a new assignment with a new value of the return that
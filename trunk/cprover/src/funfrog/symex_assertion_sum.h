@@ -13,6 +13,7 @@ The output of symbolic execution is a system of equations, assertions and assump
 #include <util/symbol.h>
 #include <goto-symex/goto_symex.h>
 #include "partition_fwd.h"
+#include "unwind_bounds.h"
 #include <queue>
 #include <funfrog/summary_store.h>
 
@@ -23,6 +24,7 @@ class assertion_infot;
 class call_tree_nodet;
 class partitioning_target_equationt;
 class partition_ifacet;
+class interval_invariantst;
 
 using partition_iface_ptrst = std::list<partition_ifacet*>;
 
@@ -98,11 +100,25 @@ public:
       return equation;
   }
 
+  // False if the result does not depend on the unwind bound of the loops
+  bool is_loop_bound_reached() const { return loop_bound_reached; }
+
   std::map<irep_idt, std::string> guard_expln;
 
   void set_assertion_info_to_verify(const assertion_infot* assertion_info){
       current_assertion = assertion_info;
   }
+
+  // Invariants of the program (of the same goto functions) used to constrain
+  // the call sites and to prune the unreachable ones
+  void set_invariants(const interval_invariantst* _invariants){
+      invariants = _invariants;
+  }
+
+  // Per-loop bounds of the automatic unwinding, instead of the single bound
+  void set_unwind_bounds(unwind_boundst* _unwind_bounds){
+      unwind_bounds = _unwind_bounds;
+  }
   
 protected:
   std::unique_ptr<statet> state; //HiFrog specific.
@@ -150,6 +166,8 @@ protected:
   // refers to Current assertion in process //In symex when there are multiple assertins(all-claims) only one claim at a time is processed
   const assertion_infot* current_assertion {nullptr};
 
+  const interval_invariantst* invariants {nullptr};
+
   const goto_programt &goto_program;
 
   unsigned last_assertion_loc;
@@ -226,6 +244,11 @@ protected:
   // Marks the SSA symbols of accessed globals
   void mark_accessed_global_symbols(const irep_idt & function_id, partition_ifacet & partition_iface);
 
+  // Records the values of arguments and accessed globals known at the call site
+  // (due to constant propagation); used to specialize the summary of the call
+  void mark_argument_values(statet & state, const code_typet & function_type,
+                            const exprt::operandst & arguments, partition_ifacet & partition_iface);
+
   // Assigns values from the modified global variables. Marks the SSA symbol 
   // of the global variables for later use when processing the deferred function
   void modified_globals_assignment_and_mark(
@@ -327,6 +350,9 @@ protected:
   }
 
    protected:
+  // Clears the log of level2 changes when no branch is waiting for a merge
+  void release_change_log(statet &state);
+
   // override from goto_symex.h
   void phi_function(
     const statet::goto_statet &goto_state,
@@ -338,20 +364,32 @@ protected:
     const std::string &msg,
     statet &state) override;
 
- //for loop unwinding //SA: check for usage 5.11
-  virtual bool get_unwind(
+  // for loop unwinding
+  bool should_stop_unwind(
     const symex_targett::sourcet &source,
     const goto_symex_statet::call_stackt &call_stack, // KE: changed to fit the override
-    unsigned unwind)
+    unsigned unwind) override
   {
     // returns true if we should not continue unwinding
-    // for support of different bounds in different loops, see how it's done in symex_bmct
+    if (unwind_bounds) {
+      return unwind >= unwind_bounds->get_loop_bound(id2string(source.pc->function), source.pc->source_location,
+                                                     source.pc->loop_number);
+    }
     return unwind >= max_unwind;
   }
 
+  // override from goto_symex.h
+  void loop_bound_exceeded(statet &state, const exprt &guard) override;
+
   // unwind option
   unsigned int max_unwind;
 
+  // Has a (reachable) loop been cut by the unwind bound?
+  bool loop_bound_reached {false};
+
+  // the exceeded loops are recorded there
+  unwind_boundst* unwind_bounds {nullptr};
+
   /* Temporary fix to deal with loops
    * taken from void goto_symext::symex_goto(statet &state)
    * in symex_goto.cpp
@@ -386,6 +424,9 @@ private:
 
     void analyze_globals_rec(irep_idt function_to_analyze, std::unordered_set<irep_idt, irep_id_hash> & analyzed_functions);
 
+    // Drops the modified globals that are dead after every call of the function
+    void reduce_modified_globals();
+
   // Methods for manipulating symbols: creating new artifical symbols, getting the current L2 version of a symbol,
   // getting the next version of a symbol, etc.
 
@@ -443,6 +484,8 @@ private:
     // Clear the state
     state.reset(new statet());
     ns = namespacet{outer_symbol_table, state->symbol_table};
+    // phi_function merges only the entries changed since the branch
+    state->level2.record_changes = true;
     // since not supporting multiple threads, we do not need to record events;
     turn_off_recording_events();
   }
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <funfrog/solvers/smtcheck_opensmt2_lra.h>
+#include <util/arith_tools.h>
+#include <util/std_expr.h>
+
+#ifdef PRODUCE_PROOF
+
+namespace {
+    binary_relation_exprt at_most(const symbol_exprt & var, int bound) {
+        return binary_relation_exprt{var, ID_le, from_integer(bound, var.type())};
+    }
+}
+
+TEST(test_MinimizeSummary, test_ImpliedConjunctsDropped){
+    solver_optionst options;
+    smtcheck_opensmt2t_lra solver {options, "test_solver"};
+    symbol_exprt x{"x", signedbv_typet{32}};
+    PTRef tight = solver.expression_to_ptref(at_most(x, 1));
+    PTRef summary = solver.expression_to_ptref(and_exprt{at_most(x, 1), and_exprt{at_most(x, 2), at_most(x, 3)}});
+    EXPECT_EQ(solver.minimize_summary(summary), tight);
+}
+
+TEST(test_MinimizeSummary, test_IndependentConjunctsKept){
+    solver_optionst options;
+    smtcheck_opensmt2t_lra solver {options, "test_solver"};
+    symbol_exprt x{"x", signedbv_typet{32}};
+    symbol_exprt y{"y", signedbv_typet{32}};
+    PTRef summary = solver.expression_to_ptref(and_exprt{at_most(x, 1), at_most(y, 1)});
+    PTRef minimized = solver.minimize_summary(summary);
+    ASSERT_TRUE(solver.isConjunctive(minimized));
+    EXPECT_EQ(solver.getLogic()->getPterm(minimized).size(), 2);
+}
+
+// Above the limit the summary is only flattened, and the user is told so
+TEST(test_MinimizeSummary, test_LimitReported){
+    solver_optionst options;
+    smtcheck_opensmt2t_lra solver {options, "test_solver"};
+    symbol_exprt x{"x", signedbv_typet{32}};
+    const int conjuncts = smtcheck_opensmt2t::max_minimized_conjuncts + 1;
+    exprt::operandst bounds;
+    for (int i = 0; i < conjuncts; ++i) {
+        bounds.push_back(at_most(x, i));
+    }
+    PTRef summary = solver.expression_to_ptref(conjunction(bounds));
+    testing::internal::CaptureStderr();
+    PTRef minimized = solver.minimize_summary(summary);
+    std::string warning = testing::internal::GetCapturedStderr();
+    EXPECT_NE(warning.find("not minimized"), std::string::npos);
+    ASSERT_TRUE(solver.isConjunctive(minimized));
+    EXPECT_EQ(solver.getLogic()->getPterm(minimized).size(), conjuncts);
+}
+
+#endif // PRODUCE_PROOF
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <util/string_container.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Each thread interns the shared strings (in its own order) and its own strings,
+    // checking every number right away while the other threads keep adding strings
+    void intern_strings(string_containert & container, unsigned thread_id, unsigned shared_count,
+                        unsigned own_count, std::vector<unsigned> & shared_numbers, bool & consistent) {
+        shared_numbers.assign(shared_count, 0);
+        for (unsigned i = 0; i < shared_count; ++i) {
+            const unsigned index = (i * 7919 + thread_id * 101) % shared_count;
+            const std::string s = "shared_" + std::to_string(index);
+            const unsigned no = container[s];
+            shared_numbers[index] = no;
+            consistent &= container.get_string(no) == s;
+        }
+        for (unsigned i = 0; i < own_count; ++i) {
+            const std::string s = "own_" + std::to_string(thread_id) + "_" + std::to_string(i);
+            const unsigned no = container[s];
+            consistent &= container.get_string(no) == s && std::string{container.c_str(no)} == s;
+        }
+    }
+}
+
+TEST(test_StringContainer, test_SingleThread_Numbers){
+    std::unique_ptr<string_containert> container{new string_containert};
+    // the empty string and the irep ids are interned first
+    EXPECT_EQ((*container)[""], 0u);
+    const unsigned first = (*container)["test_string_1"];
+    const unsigned second = (*container)["test_string_2"];
+    EXPECT_EQ(second, first + 1);
+    EXPECT_EQ((*container)[std::string{"test_string_1"}], first);
+    EXPECT_EQ(container->get_string(second), "test_string_2");
+}
+
+// Enough strings to fill more than one block of numbers, interned from several threads at once
+TEST(test_StringContainer, test_ConcurrentInterning){
+    const unsigned thread_count = 8;
+    const unsigned shared_count = 40000;
+    const unsigned own_count = 4000;
+    std::unique_ptr<string_containert> container{new string_containert};
+    const unsigned before = (*container)["before_threads"];
+    std::vector<std::vector<unsigned>> shared_numbers(thread_count);
+    std::unique_ptr<bool[]> consistent{new bool[thread_count]};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        consistent[t] = true;
+        threads.emplace_back(intern_strings, std::ref(*container), t, shared_count, own_count,
+                             std::ref(shared_numbers[t]), std::ref(consistent[t]));
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    for (unsigned t = 0; t < thread_count; ++t) {
+        EXPECT_TRUE(consistent[t]);
+        // every thread got the same number for the same string
+        EXPECT_EQ(shared_numbers[t], shared_numbers[0]);
+    }
+    for (unsigned i = 0; i < shared_count; ++i) {
+        EXPECT_EQ(container->get_string(shared_numbers[0][i]), "shared_" + std::to_string(i));
+    }
+    // no string got two numbers and no number was skipped
+    EXPECT_EQ((*container)["after_threads"], before + 1 + shared_count + thread_count * own_count);
+}
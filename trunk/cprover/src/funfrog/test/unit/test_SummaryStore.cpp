@@ -56,3 +56,71 @@ TEST(test_Insert, test_Insert_Different_Prop){
 }
 
 
+
+TEST(test_ContextSummary, test_Context_Signature){
+    summary_storet* ss = new smt_summary_storet;
+    std::string fun{"foo"};
+    smt_itpt* itp1 = new smt_itpt;
+    itp1->setInterpolant(PTRef{1});
+    auto id1 = ss->insert_summary(itp1, fun);
+    ss->register_summary_context(id1, fun, 10, 100);
+    smt_itpt* itp2 = new smt_itpt;
+    itp2->setInterpolant(PTRef{2});
+    auto id2 = ss->insert_summary(itp2, fun);
+    ss->register_summary_context(id2, fun, 10, 200);
+    smt_itpt* itp3 = new smt_itpt;
+    itp3->setInterpolant(PTRef{3});
+    auto id3 = ss->insert_summary(itp3, fun);
+    ss->register_summary_context(id3, fun, 20, 100);
+    // the same call site signature and calling context
+    ASSERT_EQ(ss->find_context_summary(fun, 10, 100), id1);
+    ASSERT_EQ(ss->find_context_summary(fun, 20, 100), id3);
+    // the same signature in another context, the latest summary wins
+    ASSERT_EQ(ss->find_context_summary(fun, 10, 300), id2);
+    // no call site with that signature, although the function has summaries
+    ASSERT_EQ(ss->find_context_summary(fun, 30, 100), 0);
+    ASSERT_EQ(ss->find_context_summary("bar", 10, 100), 0);
+    delete ss;
+}
+
+TEST(test_ContextSummary, test_Context_Unregistered){
+    summary_storet* ss = new smt_summary_storet;
+    std::string fun{"foo"};
+    smt_itpt* itp1 = new smt_itpt;
+    itp1->setInterpolant(PTRef{1});
+    auto id1 = ss->insert_summary(itp1, fun);
+    smt_itpt* itp2 = new smt_itpt;
+    itp2->setInterpolant(PTRef{2});
+    auto id2 = ss->insert_summary(itp2, fun);
+    ss->register_summary_context(id2, fun, 10, 100);
+    // a summary without a call site (e.g., read from a file) is used where no compatible one exists
+    ASSERT_TRUE(ss->function_has_summaries(fun));
+    ASSERT_EQ(ss->find_context_summary(fun, 20, 100), id1);
+    ASSERT_EQ(ss->find_context_summary(fun, 10, 300), id2);
+    ss->remove_summary(id2);
+    ASSERT_EQ(ss->find_context_summary(fun, 10, 100), id1);
+    ASSERT_EQ(ss->get_summariesID(fun).size(), 1);
+    ASSERT_EQ(ss->get_summariesID(fun)[0], id1);
+    delete ss;
+}
+
+TEST(test_ReadOnly, test_ReadOnly_Changes){
+    summary_storet* ss = new smt_summary_storet;
+    std::string fun{"foo"};
+    smt_itpt* itp1 = new smt_itpt;
+    itp1->setInterpolant(PTRef{1});
+    auto id1 = ss->insert_summary(itp1, fun);
+    ss->set_read_only(true);
+    // reading is fine, every change throws
+    ASSERT_EQ(ss->find_context_summary(fun, 10, 100), id1);
+    smt_itpt* itp2 = new smt_itpt;
+    itp2->setInterpolant(PTRef{2});
+    ASSERT_THROW(ss->insert_summary(itp2, fun), std::logic_error);
+    ASSERT_THROW(ss->register_summary_context(id1, fun, 10, 100), std::logic_error);
+    ASSERT_THROW(ss->remove_summary(id1), std::logic_error);
+    ss->set_read_only(false);
+    ss->register_summary_context(id1, fun, 10, 100);
+    ASSERT_EQ(ss->find_context_summary(fun, 10, 100), id1);
+    delete itp2;
+    delete ss;
+}
@@ -19,3 +19,19 @@ TEST(test_UnsupportedFunction, test_UnsupportedFunction_TwoSolvers_SameExpressio
     smtcheck_opensmt2t_uf uf_solver2 {options, "test_solver2"};
     EXPECT_NO_THROW(uf_solver2.expression_to_ptref(mod_expr));
 }
+
+// Solvers created from the same options continue one numbering of unsupported variables, other options start anew
+TEST(test_UnsupportedFunction, test_UnsupportedRegistry_PerOptions){
+    address_of_exprt address{symbol_exprt{"x", signedbv_typet{32}}};
+    solver_optionst options1;
+    smtcheck_opensmt2t_uf uf_solver1 {options1, "test_solver1"};
+    (void) uf_solver1.expression_to_ptref(address);
+    smtcheck_opensmt2t_uf uf_solver2 {options1, "test_solver2"};
+    (void) uf_solver2.expression_to_ptref(address);
+    EXPECT_EQ(options1.m_unsupported_registry->get_unsupported_vars_count(), 2u);
+
+    solver_optionst options2;
+    smtcheck_opensmt2t_uf uf_solver3 {options2, "test_solver3"};
+    (void) uf_solver3.expression_to_ptref(address);
+    EXPECT_EQ(options2.m_unsupported_registry->get_unsupported_vars_count(), 1u);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <funfrog/unwind_bounds.h>
+#include <util/source_location.h>
+#include <sstream>
+
+namespace {
+    source_locationt at_line(unsigned line) {
+        source_locationt location;
+        location.set_file("main.c");
+        location.set_line(line);
+        return location;
+    }
+}
+
+TEST(UnwindBounds_test, test_OnlyExceededRaised)
+{
+    unwind_boundst bounds{2};
+    bounds.loop_bound_exceeded("main", at_line(10), 0);
+    ASSERT_TRUE(bounds.has_exceeded_loops());
+    ASSERT_EQ(bounds.raise_exceeded_bounds(10), 1);
+    ASSERT_FALSE(bounds.has_exceeded_loops());
+    ASSERT_EQ(bounds.get_loop_bound("main", at_line(10), 0), 4);
+    ASSERT_EQ(bounds.get_loop_bound("main", at_line(11), 1), 2);
+    ASSERT_EQ(bounds.get_loop_bound("f", at_line(10), 0), 2);
+}
+
+TEST(UnwindBounds_test, test_MaxBound)
+{
+    unwind_boundst bounds{3};
+    bounds.loop_bound_exceeded("main", at_line(10), 0);
+    ASSERT_EQ(bounds.raise_exceeded_bounds(5), 1);
+    ASSERT_EQ(bounds.get_loop_bound("main", at_line(10), 0), 5);
+    bounds.loop_bound_exceeded("main", at_line(10), 0);
+    ASSERT_EQ(bounds.raise_exceeded_bounds(5), 0);
+    ASSERT_EQ(bounds.get_loop_bound("main", at_line(10), 0), 5);
+}
+
+TEST(UnwindBounds_test, test_Serialization)
+{
+    unwind_boundst bounds{2};
+    bounds.loop_bound_exceeded("c::f", at_line(13), 3);
+    bounds.raise_exceeded_bounds(100);
+    bounds.recursion_unwound("fib", 4);
+    bounds.recursion_unwound("fib", 2);
+    std::stringstream stream;
+    bounds.serialize(stream);
+
+    unwind_boundst loaded{2};
+    loaded.deserialize(stream);
+    ASSERT_EQ(loaded.get_loop_bound("c::f", at_line(13), 3), 4);
+    ASSERT_EQ(loaded.get_recursion_depth("fib"), 4);
+    ASSERT_EQ(loaded.get_recursion_depth("main"), 0);
+}
+
+// The bound belongs to the loop at its location, whatever its number is in another version of the program
+TEST(UnwindBounds_test, test_KeyedByLocation)
+{
+    unwind_boundst bounds{2};
+    bounds.loop_bound_exceeded("main", at_line(10), 0);
+    bounds.raise_exceeded_bounds(10);
+    ASSERT_EQ(bounds.get_loop_bound("main", at_line(10), 1), 4);
+    ASSERT_EQ(bounds.get_loop_bound("main", at_line(20), 0), 2);
+
+    // a loop without a location is identified by its number
+    bounds.loop_bound_exceeded("main", source_locationt{}, 3);
+    bounds.raise_exceeded_bounds(10);
+    ASSERT_EQ(bounds.get_loop_bound("main", source_locationt{}, 3), 4);
+    ASSERT_EQ(bounds.get_loop_bound("main", source_locationt{}, 4), 2);
+
+    std::stringstream stream;
+    bounds.serialize(stream);
+    unwind_boundst loaded{2};
+    loaded.deserialize(stream);
+    ASSERT_EQ(loaded.get_loop_bound("main", at_line(10), 5), 4);
+    ASSERT_EQ(loaded.get_loop_bound("main", source_locationt{}, 3), 4);
+}
@@ -98,6 +98,9 @@ bool theory_refinert::assertion_holds_smt(const assertion_infot& assertion,
   symex.set_assertion_info_to_verify(&assertion);
 
   formula_managert ssaTosmt = formula_managert(equation, message_handler);
+  if (options.get_bool_option("replay-cex")) {
+      ssaTosmt.set_replay_program(omega.get_goto_functions(), symbol_table);
+  }
 
   bool end = symex.prepare_SSA();
 
@@ -117,6 +120,11 @@ bool theory_refinert::assertion_holds_smt(const assertion_infot& assertion,
       status() << "ASSERTION HOLDS" << "\n" << eom;
       report_success();
 
+  } else if (options.get_bool_option("replay-cex") && ssaTosmt.is_cex_reproducible(*decider)) {
+      // the counterexample of the coarse encoding is real, nothing to refine
+      status() << "ASSERTION DOES NOT HOLD (counterexample reproduced concretely)" << "\n" << eom;
+      report_failure();
+
   } else {  //do refinement
 
    error_tracet error_trace;
@@ -392,7 +400,7 @@ void theory_refinert::report_success()
 
 void theory_refinert::slice_target(partitioning_target_equationt & equation) {
     auto before = timestamp();
-    statistics() << "All SSA steps: " << equation.SSA_steps.size() << eom;
+    statistics() << "All SSA steps: " << equation.get_SSA_steps_count() << eom;
     partitioning_slice(equation);
     statistics() << "Ignored SSA steps after slice: " << equation.count_ignored_SSA_steps() << eom;
     auto after = timestamp();
@@ -22,6 +22,7 @@ public:
           ui_message_handlert & _message_handler
   ) :
       goto_program(_goto_program),
+      symbol_table(_outer_symbol_table),
       ns{_outer_symbol_table},
       options(_options),
       message_handler (_message_handler),
@@ -39,6 +40,7 @@ public:
   
 private:
   const goto_programt &goto_program;
+  const symbol_tablet &symbol_table;
   namespacet ns;
   const optionst &options;
   ui_message_handlert &message_handler;
@@ -26,6 +26,10 @@ protected:
     unsigned unwind = rec_unwind[target_function];
     return unwind > 0;
   }
+
+  void reset_unwinding_counters(){
+    rec_unwind.clear();
+  }
   
 private:
   std::map<irep_idt, unsigned> rec_unwind;
@@ -0,0 +1,107 @@
+/*******************************************************************
+
+ Module: Per-loop unwind bounds and recursion depths found by the
+ automatic unwinding (--unwind-auto)
+
+\*******************************************************************/
+
+#include "unwind_bounds.h"
+
+#include <util/source_location.h>
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+unwind_boundst::loop_keyt unwind_boundst::loop_key(const std::string & function_id,
+                                                    const source_locationt & location, unsigned loop_number)
+{
+  if (location.get_line().empty()) {
+    // no line to identify the loop by (e.g., a loop created by an instrumentation)
+    return loop_keyt{function_id, "#" + std::to_string(loop_number)};
+  }
+  return loop_keyt{function_id, id2string(location.get_file()) + ':' + id2string(location.get_line())
+                                + ':' + id2string(location.get_column())};
+}
+
+unsigned unwind_boundst::get_loop_bound(const std::string & function_id, const source_locationt & location,
+                                        unsigned loop_number) const
+{
+  auto it = loop_bounds.find(loop_key(function_id, location, loop_number));
+  return it == loop_bounds.end() ? default_bound : it->second;
+}
+
+void unwind_boundst::loop_bound_exceeded(const std::string & function_id, const source_locationt & location,
+                                         unsigned loop_number)
+{
+  exceeded_loops.insert(loop_key(function_id, location, loop_number));
+}
+
+/*******************************************************************
+ Function: unwind_boundst::raise_exceeded_bounds
+
+ Purpose: Only the loops cut by their bound in the last check get a
+ larger bound, the other loops are fully unwound already
+\*******************************************************************/
+unsigned unwind_boundst::raise_exceeded_bounds(unsigned max_bound)
+{
+  unsigned raised = 0;
+  for (const auto & loop : exceeded_loops) {
+    auto it = loop_bounds.find(loop);
+    const unsigned bound = it == loop_bounds.end() ? default_bound : it->second;
+    if (bound >= max_bound) { continue; }
+    loop_bounds[loop] = bound > max_bound / 2 ? max_bound : 2 * bound;
+    ++raised;
+  }
+  exceeded_loops.clear();
+  return raised;
+}
+
+unsigned unwind_boundst::get_recursion_depth(const std::string & function_id) const
+{
+  auto it = recursion_depths.find(function_id);
+  return it == recursion_depths.end() ? 0 : it->second;
+}
+
+void unwind_boundst::recursion_unwound(const std::string & function_id, unsigned depth)
+{
+  unsigned & known = recursion_depths[function_id];
+  known = std::max(known, depth);
+}
+
+void unwind_boundst::serialize(std::ostream & out) const
+{
+  for (const auto & loop : loop_bounds) {
+    out << "loop " << loop.second << ' ' << loop.first.first << ' ' << loop.first.second << '\n';
+  }
+  for (const auto & recursion : recursion_depths) {
+    out << "recursion " << recursion.second << ' ' << recursion.first << '\n';
+  }
+}
+
+void unwind_boundst::deserialize(std::istream & in)
+{
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream entry(line);
+    std::string kind;
+    unsigned number = 0;
+    entry >> kind >> number;
+    if (kind == "loop") {
+      // the location is the rest of the line, a file name may contain spaces
+      std::string function_id;
+      std::string location;
+      if (entry >> function_id >> std::ws && std::getline(entry, location)) {
+        unsigned & known = loop_bounds.emplace(loop_keyt{function_id, location}, number).first->second;
+        known = std::max(known, number);
+      }
+    }
+    else if (kind == "recursion") {
+      std::string function_id;
+      if (entry >> std::ws && std::getline(entry, function_id)) {
+        recursion_unwound(function_id, number);
+      }
+    }
+  }
+}
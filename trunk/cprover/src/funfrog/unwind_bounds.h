@@ -0,0 +1,68 @@
+/*******************************************************************
+
+ Module: Per-loop unwind bounds and recursion depths found by the
+ automatic unwinding (--unwind-auto)
+
+ A loop is keyed by its function and the source location of its backward
+ jump (the loop number changes as soon as a loop is added or removed
+ before it, e.g., in an upgraded version); it starts with the default
+ bound and only the loops cut by their bound get a larger one.
+ The depths of the recursive calls unwound by the refinement are kept
+ too, so a later run unwinds them right away. The table is stored next
+ to the summaries, so the bounds are reused by the following runs.
+
+\*******************************************************************/
+
+#ifndef HIFROG_UNWIND_BOUNDS_H
+#define HIFROG_UNWIND_BOUNDS_H
+
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+class source_locationt;
+
+class unwind_boundst
+{
+public:
+  explicit unwind_boundst(unsigned _default_bound) : default_bound(_default_bound) {}
+
+  // The loop number identifies only the loops without a source location
+  unsigned get_loop_bound(const std::string & function_id, const source_locationt & location,
+                          unsigned loop_number) const;
+
+  // The loop is reachable after its last unwinding; its bound is raised by raise_exceeded_bounds
+  void loop_bound_exceeded(const std::string & function_id, const source_locationt & location,
+                           unsigned loop_number);
+
+  bool has_exceeded_loops() const { return !exceeded_loops.empty(); }
+
+  // Doubles the bounds of the exceeded loops (up to the maximum); returns the number of raised bounds
+  unsigned raise_exceeded_bounds(unsigned max_bound);
+
+  // 0 if the recursion of the function was never unwound
+  unsigned get_recursion_depth(const std::string & function_id) const;
+
+  void recursion_unwound(const std::string & function_id, unsigned depth);
+
+  // One entry per line: "loop <bound> <function> <location>" or "recursion <depth> <function>"
+  void serialize(std::ostream & out) const;
+  // Merges the entries with the current ones, the larger bound wins
+  void deserialize(std::istream & in);
+
+private:
+  // The function and the location (file:line:column) of the loop
+  typedef std::pair<std::string, std::string> loop_keyt;
+
+  static loop_keyt loop_key(const std::string & function_id, const source_locationt & location,
+                            unsigned loop_number);
+
+  unsigned default_bound;
+  std::map<loop_keyt, unsigned> loop_bounds;
+  std::set<loop_keyt> exceeded_loops;
+  std::map<std::string, unsigned> recursion_depths;
+};
+
+#endif //HIFROG_UNWIND_BOUNDS_H
@@ -37,6 +37,15 @@ void parser_upprovert::help()
     "                               (treshold = number of SSA steps)\n"
     "                               and check stronger claims at once\n"
     "--unwind <bound>               loop unwind bound\n"
+    "--unwind-deepening <min>:<max>:<step>\n"
+    "                               check with increasing unwind bounds until a claim\n"
+    "                               fails or no loop reaches the bound (each bound\n"
+    "                               is checked from scratch; not with --bootstrapping,\n"
+    "                               --summary-validation or --sanity-check)\n"
+    "--unwind-auto <max>            start with --unwind (default 2) and raise the bounds\n"
+    "                               of the loops cut by them up to <max>; the bounds\n"
+    "                               are stored next to the summaries (same restrictions\n"
+    "                               as --unwind-deepening, not with --theoref)\n"
     "--partial-loops                do not forbid paths with unsufficient loop unwinding (due to unwind bound)\n"
     "--type-constraints             LRA's and LIA's basic constraints on numerical data type\n"
     "                                 0 - no additional constraints,\n"
@@ -54,7 +63,21 @@ void parser_upprovert::help()
     "                               summaries (saves few cheap SAT calls)\n"
     "--no-error-trace               disable the counter example's print once a real bug found\n"
     "--no-itp                       do not construct summaries (just report SAFE/BUG)\n"
-    "--no-partitions                do not use partitions to create the BMC formula\n\n"
+    "--no-partitions                do not use partitions to create the BMC formula\n"
+    "--preprocess-threads <n>       run the function-local preprocessing passes\n"
+    "                               on <n> threads (needs thread-safe ireps)\n"
+    "--stream-conversion            convert the finished partitions to SMT on a separate\n"
+    "                               thread during symex (needs thread-safe ireps)\n"
+    "--low-memory                   release the SSA steps once they are converted\n"
+    "                               (the error trace then needs a second run)\n\n"
+  "--replay-cex                   replay counterexamples of over-approximating\n"
+  "                               encodings on the concrete interpreter, to\n"
+  "                               report them as real bugs if reproduced\n\n"
+  "--shared-symex                 check all the claims on one SSA form, switching\n"
+  "                               off the violated ones between solver calls\n\n"
+  "--drop-unused-functions        drop the functions not reachable from the entry\n"
+  "                               point before the preprocessing (the claims are\n"
+  "                               numbered in the remaining functions)\n\n"
     "--solver                       SMT solving option, solver type:\n"
     "                                 osmt - use OpenSMT2 solver,\n"
     "                                 z3   - use Z3 solver\n"
@@ -257,19 +280,47 @@ int parser_upprovert::doit()
   calculate_show_claims(goto_model);
   
   if(validate_input_options()) {
+    // the invariants hold for this version only, so would the summaries constrained by them
+    if (cmdline.isset("interval-invariants")) {
+      error_interface("--interval-invariants is not supported in UpProver");
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
     //preparation for UpProver
     if(cmdline.isset("bootstrapping") || cmdline.isset("summary-validation") || cmdline.isset("sanity-check")){
+      // the summaries of the bootstrapping must be for one bound
+      if (cmdline.isset("unwind-deepening") || cmdline.isset("unwind-auto")) {
+        error_interface("--unwind-deepening and --unwind-auto are supported only in the standalone check");
+        return CPROVER_EXIT_USAGE_ERROR;
+      }
       trigger_upprover(goto_model);
       status_interface("#X: Done.");
       return CPROVER_EXIT_SUCCESS;
     }
     //perform standalone check for stream of assertions in a specific source file
-    check_claims(goto_model,
-                 claim_checkmap,
-                 claim_numbers,
-                 options,
-                 ui_message_handler,
-                 claim_user_nr);
+    if (cmdline.isset("unwind-auto")) {
+      check_claims_auto(goto_model,
+                        claim_checkmap,
+                        claim_numbers,
+                        options,
+                        ui_message_handler,
+                        claim_user_nr);
+    }
+    else if (cmdline.isset("unwind-deepening")) {
+      check_claims_deepening(goto_model,
+                               claim_checkmap,
+                               claim_numbers,
+                               options,
+                               ui_message_handler,
+                               claim_user_nr);
+    }
+    else {
+      check_claims(goto_model,
+                   claim_checkmap,
+                   claim_numbers,
+                   options,
+                   ui_message_handler,
+                   claim_user_nr);
+    }
   }
   else {
     status_interface("Please check --help to revise the user's options ");
@@ -15,9 +15,9 @@
   "(bootstrapping)(summary-validation):(sanity-check):" \
   "(save-queries)(save-change-impact):" \
   "(tree-interpolants)(proof-trans):(reduce-proof)(reduce-proof-time):(reduce-proof-loops):(reduce-proof-graph):(color-proof):" \
-  "(random-seed):(no-partitions)(no-itp)(verbose-solver):" \
+  "(random-seed):(no-partitions)(no-itp)(verbose-solver):(preprocess-threads):(stream-conversion)(low-memory)(replay-cex)(interval-invariants)(shared-symex)(drop-unused-functions)" \
   "(itp-algorithm): (itp-uf-algorithm): (itp-lra-algorithm):(itp-lra-factor): (check-itp): (part-itp):" \
-  "(unwind):(unwindset):" \
+  "(unwind):(unwindset):(unwind-deepening):(unwind-auto):" \
   "(type-constraints):(type-byte-constraints):" \
   "(inlining-limit):(testclaim):" \
   "(no-error-trace)" \
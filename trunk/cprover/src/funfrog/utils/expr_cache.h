@@ -0,0 +1,114 @@
+/*
+ * File:   expr_cache.h
+ *
+ * Cache from expressions to their conversions (e.g., PTRefs).
+ *
+ * Expressions in the SSA share most of their subtrees, so the cache
+ * first looks an expression up by the identity of its irep node; only
+ * if that fails it compares structurally. The structural hash of every
+ * node is computed once and remembered by node identity too, so
+ * a subtree shared by many parents is hashed only once.
+ *
+ * The cache keeps a reference to every node it has seen, hence a node
+ * is never freed (and its address never reused) while it is cached.
+ * retain drops the nodes no longer used elsewhere, so they can be freed.
+ */
+
+#ifndef EXPR_CACHE_H
+#define EXPR_CACHE_H
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include <util/expr.h>
+#include <util/irep_hash.h>
+
+template<typename Value>
+class expr_cachet
+{
+public:
+    expr_cachet() : by_structure(16, structural_hasht{this}) {}
+
+    expr_cachet(const expr_cachet &) = delete;
+    expr_cachet & operator=(const expr_cachet &) = delete;
+
+    // returns nullptr if the expression is not in the cache
+    const Value * find(const exprt & expr)
+    {
+        const auto id_it = by_identity.find(&expr.read());
+        if (id_it != by_identity.end()) { return &id_it->second; }
+        const auto it = by_structure.find(expr);
+        if (it == by_structure.end()) { return nullptr; }
+        // the next lookup of this node is direct
+        return &by_identity.emplace(&expr.read(), it->second).first->second;
+    }
+
+    bool contains(const exprt & expr) { return find(expr) != nullptr; }
+
+    void insert(const exprt & expr, const Value & value)
+    {
+        by_structure.emplace(expr, value);
+        by_identity.emplace(&expr.read(), value);
+    }
+
+    std::size_t size() const { return by_structure.size(); }
+
+    // Keeps only the entries (and the remembered hashes) of the given nodes;
+    // the values of the dropped expressions are computed again if needed
+    void retain(const std::unordered_set<const irept::dt *> & used)
+    {
+        erase_unused(by_identity, used);
+        erase_unused(hashes, used);
+        for (auto it = by_structure.begin(); it != by_structure.end(); ) {
+            if (used.count(&it->first.read()) == 0) { it = by_structure.erase(it); }
+            else { ++it; }
+        }
+    }
+
+private:
+    struct hashed_nodet
+    {
+        irept node; // keeps the node alive
+        std::size_t hash;
+    };
+
+    // same as irept::hash, using the hashes of the children remembered
+    std::size_t node_hash(const irept & irep)
+    {
+        const auto it = hashes.find(&irep.read());
+        if (it != hashes.end()) { return it->second.hash; }
+
+        std::size_t result = irep_id_hash()(irep.id());
+        for (const auto & sub : irep.get_sub()) {
+            result = hash_combine(result, node_hash(sub));
+        }
+        for (const auto & named : irep.get_named_sub()) {
+            result = hash_combine(result, irep_id_hash()(named.first));
+            result = hash_combine(result, node_hash(named.second));
+        }
+        result = hash_finalize(result, irep.get_named_sub().size() + irep.get_sub().size());
+        hashes.emplace(&irep.read(), hashed_nodet{irep, result});
+        return result;
+    }
+
+    template<typename Map>
+    static void erase_unused(Map & map, const std::unordered_set<const irept::dt *> & used)
+    {
+        for (auto it = map.begin(); it != map.end(); ) {
+            if (used.count(it->first) == 0) { it = map.erase(it); }
+            else { ++it; }
+        }
+    }
+
+    struct structural_hasht
+    {
+        expr_cachet * cache;
+        std::size_t operator()(const exprt & expr) const { return cache->node_hash(expr); }
+    };
+
+    std::unordered_map<const irept::dt *, hashed_nodet> hashes;
+    std::unordered_map<const irept::dt *, Value> by_identity;
+    std::unordered_map<exprt, Value, structural_hasht> by_structure;
+};
+
+#endif /* EXPR_CACHE_H */
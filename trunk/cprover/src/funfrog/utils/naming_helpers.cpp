@@ -82,6 +82,8 @@ const std::string HifrogStringConstants::TMP_RETURN{"$tmp::return_value"};
 const std::string HifrogStringConstants::CALLSTART_SYMBOL{"hifrog::fun_start"};
 const std::string HifrogStringConstants::CALLEND_SYMBOL{"hifrog::fun_end"};
 const std::string HifrogStringConstants::ERROR_SYMBOL{"hifrog::?err"};
+const std::string HifrogStringConstants::CLAIM_SELECTOR{"hifrog::?claim"};
+const std::string HifrogStringConstants::LOOP_FUNCTION{"$loop"};
 
 const std::string CProverStringConstants::INITIALIZE_METHOD{"__CPROVER_initialize"};
 const std::string CProverStringConstants::IO_CONST{"symex::io::"};
@@ -17,6 +17,8 @@ struct HifrogStringConstants {
   static const std::string CALLSTART_SYMBOL;
   static const std::string CALLEND_SYMBOL;
   static const std::string ERROR_SYMBOL;
+  static const std::string CLAIM_SELECTOR;
+  static const std::string LOOP_FUNCTION;
 };
 
 struct SMTConstants{
@@ -71,6 +73,12 @@ void clean_name(std::string & name);
 //
 bool fun_name_contains_counter(const std::string & name);
 
+// Functions made of loops by outline_loops
+inline bool is_outlined_loop(const std::string& name)
+{
+  return name.find(HifrogStringConstants::LOOP_FUNCTION) != std::string::npos;
+}
+
 inline bool is_cprover_initialize_method(const std::string& name)
 {
   return name == CProverStringConstants::INITIALIZE_METHOD;
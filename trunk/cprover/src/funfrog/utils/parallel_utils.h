@@ -0,0 +1,64 @@
+/*
+ * File:   parallel_utils.h
+ *
+ * Runs a job on every item of a vector using a fixed number of worker
+ * threads. The items are handed out one by one, so the job should only
+ * touch its own item (and read shared data). The first exception thrown
+ * by a job is rethrown in the calling thread once all workers are done.
+ *
+ * use:
+ * parallel_for_each(items, threads, [&](item_t & item){ ... });
+ */
+
+#ifndef PARALLEL_UTILS_H
+#define PARALLEL_UTILS_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template<typename Item, typename Job>
+void parallel_for_each(std::vector<Item> & items, unsigned threads, Job job)
+{
+    if (threads <= 1 || items.size() <= 1) {
+        for (auto & item : items) {
+            job(item);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < items.size(); i = next++) {
+            try {
+                job(items[i]);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) { error = std::current_exception(); }
+                // let the other workers run out of items
+                next = items.size();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const std::size_t count = std::min<std::size_t>(threads, items.size());
+    for (std::size_t i = 1; i < count; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto & thread : workers) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif /* PARALLEL_UTILS_H */
@@ -9,8 +9,45 @@
 const std::string HifrogStringUnsupportOpConstants::UNSUPPORTED_VAR_NAME {"hifrog::c::unsupported_op2var"};
 const std::string HifrogStringUnsupportOpConstants::UNSUPPORTED_PREFIX_FUNC_NAME {"uns_"};
 
-unsigned unsupported_operationst::unsupported2var = 0; // Count how many instance of unsupported we have for all deciders
-std::vector<std::pair<std::string,exprt>> unsupported_operationst::global_unsupported_str2expr_info;
+unsigned unsupported_registryt::fresh_index()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return unsupported2var++;
+}
+
+std::string unsupported_registryt::fresh_var_name_nonlinear()
+{
+    unsigned index;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index = nonlinear2var++;
+    }
+    return quote_if_necessary( unsupported_symbol(std::string{"_sumtheoref_"}) + std::to_string(index) );
+}
+
+unsigned unsupported_registryt::get_unsupported_vars_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return unsupported2var;
+}
+
+void unsupported_registryt::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    unsupported2var = 0;
+}
+
+void unsupported_registryt::store(std::string var, const exprt & expr)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    str2expr_info.push_back(std::make_pair(std::move(var), expr));
+}
+
+std::vector<std::pair<std::string,exprt>> unsupported_registryt::get_str2expr_info() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return str2expr_info;
+}
 
 // Skip these functions and never try to refine these
 bool is_in_blacklist(const std::string & fname)
@@ -55,7 +92,7 @@ std::string unsupported_operationst::create_new_unsupported_var(std::string type
     std::string str = unsupported_symbol(type_name);
     assert(str.size() > 0); 
     
-    str = no_rename ? str : (str+"!0#"+ std::to_string(unsupported2var++));
+    str = no_rename ? str : (str+"!0#"+ std::to_string(registry->fresh_index()));
     return (no_quote ? str : quote_if_necessary(str));
 }
 
@@ -63,7 +100,7 @@ std::string unsupported_operationst::create_new_unsupported_var(std::string type
 std::string unsupported_operationst::get_failure_reason(std::string _fails_type_id)
 {
     return (!has_unsupported_vars()) ? "" // No unsupported functions, no reason
-            : "Cannot refine due to " + std::to_string(unsupported2var) + 
+            : "Cannot refine due to " + std::to_string(registry->get_unsupported_vars_count()) + 
                 " unsupported operators;e.g., " + _fails_type_id;
 }
 
@@ -86,36 +123,5 @@ void unsupported_operationst::store_new_unsupported_var(const exprt& expr, std::
     if ((_id==ID_symbol) || (_id==ID_nondet_symbol) || (_id==ID_constant)) return;
     
     // Add the abstracted expression
-    global_unsupported_str2expr_info.push_back(std::make_pair(var, expr)); // PTRef sometimes turn into 0
-}
-
-/*******************************************************************/
-// SUMMARY REFINEMENT 
-// Purpose: create non-linear fresh variable with a separate(independent) counter for summary refinement
-// No need to store this information. Once needed shall use the class functionality!
-std::string fresh_var_name_nonlinear(){
-    static int counter = 0;
-    return quote_if_necessary( unsupported_symbol(std::string{"_sumtheoref_"}) + std::to_string(counter++) );
+    registry->store(var, expr); // PTRef sometimes turn into 0
 }
-
-// SUMMARY REFINEMENT
-// Purpose: extract all unsupported function calls (uns_* e.g.,)
-std::vector<std::string> get_unsupported_funct_exprs(std::string const & text) {
-    std::vector<std::string> res;
-    const std::string UNS = "(uns_";
-    std::string::size_type last_pos = 0;
-    while ((last_pos = text.find(UNS, last_pos)) != std::string::npos) {
-        auto beg = last_pos;
-        auto current = beg + 1;
-        int counter = 0;
-        while (text[current] != ')' || counter > 0) {
-            if (text[current] == ')') { --counter; }
-            if (text[current] == '(') { ++counter; }
-            ++current;
-        }
-        auto end = current + 1;
-        res.push_back(text.substr(beg, end - beg));
-        last_pos = end;
-    }
-    return res;
-}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #ifndef UNSUPPORTEDOPERATIONS_H
 #define UNSUPPORTEDOPERATIONS_H
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <util/expr.h>
@@ -15,12 +17,6 @@ struct HifrogStringUnsupportOpConstants {
 
 #define unsupported_symbol(x) HifrogStringUnsupportOpConstants::UNSUPPORTED_VAR_NAME + x // To create in general unsupported symbol
 
-// Purpose: create non-linear fresh variable with a separate(independent) counter for summary refinement
-std::string fresh_var_name_nonlinear();
-
-// Purpose: extract all unsupported function calls (uns_* e.g.,)
-std::vector<std::string> get_unsupported_funct_exprs(std::string const & text);
-
 // Token we ignore and do not model
 bool is_in_blacklist(const std::string & fname);
 
@@ -30,11 +26,45 @@ bool is_unsupported_var_name(const std::string & name);
 // Create unsupported UF function name
 std::string unsupported_function_name(const exprt& expr);
 
+// Numbering and abstracted expressions of the unsupported operations of one
+// verification context. All the solvers of the context (and the summaries they
+// exchange) share it, so fresh names never clash between them; independent
+// contexts number from zero, whatever solvers were created before.
+class unsupported_registryt
+{
+public:
+    // Index of a new unsupported L2 variable
+    unsigned fresh_index();
+
+    // Create non-linear fresh variable with a separate(independent) counter for summary refinement
+    std::string fresh_var_name_nonlinear();
+
+    unsigned get_unsupported_vars_count() const;
+
+    void reset(); // KE: only for re-init solver use. Once we have pop in OpenSMT, please discard.
+
+    void store(std::string var, const exprt & expr);
+
+    // Copy of the abstracted expressions, in the order they were created
+    std::vector<std::pair<std::string,exprt>> get_str2expr_info() const;
+
+private:
+    mutable std::mutex mutex;
+
+    unsigned unsupported2var {0}; // Create a new var hifrog::c::unsupported_op2var#i
+
+    unsigned nonlinear2var {0};
+
+    std::vector<std::pair<std::string,exprt>> str2expr_info; // String to Expression - can pass between solvers!
+};
+
 class unsupported_operationst
 {
 public:
-    unsupported_operationst(bool _store_unsupported_info)
-            :store_unsupported_info(_store_unsupported_info)
+    unsupported_operationst(bool _store_unsupported_info,
+                            std::shared_ptr<unsupported_registryt> _registry = nullptr)
+            :store_unsupported_info(_store_unsupported_info),
+             registry(_registry ? _registry : std::make_shared<unsupported_registryt>())
     {}
             
     virtual ~unsupported_operationst() {}
@@ -52,6 +82,12 @@ public:
     
     // Info. during error trace creating (in case of failure)
     std::string get_failure_reason(std::string _fails_type_id);
+
+    // Joins the verification context of the registry (before any unsupported variable is created)
+    void set_registry(std::shared_ptr<unsupported_registryt> _registry)
+    { if (_registry) registry = _registry; }
+
+    unsupported_registryt & get_registry() { return *registry; }
     
     
     
@@ -60,8 +96,8 @@ public:
     bool is_store_unsupported_info() { return store_unsupported_info; }
     
     bool has_unsupported_info() const { return store_unsupported_info && has_unsupported_vars(); } // Common to all
-    bool has_unsupported_vars() const { return (unsupported2var > 0); } // Common to all, affects several locations!
-    void init_unsupported_counter() { unsupported2var=0; } // KE: only for re-init solver use. Once we have pop in OpenSMT, please discard.
+    bool has_unsupported_vars() const { return (registry->get_unsupported_vars_count() > 0); } // Common to all, affects several locations!
+    void init_unsupported_counter() { registry->reset(); } // KE: only for re-init solver use. Once we have pop in OpenSMT, please discard.
 
     // Shall be in protected - KE - when have time
     std::vector<exprt> unsupported_info_equations; // Keep the whole equation of expressions in unsupported_info_map
@@ -69,17 +105,13 @@ public:
     // The storage itself
     void store_new_unsupported_var(const exprt& expr, std::string var);
     
-    unsigned get_unsupported_info_map_size() { return global_unsupported_str2expr_info.size();}
-    std::vector<std::pair<std::string,exprt>>::const_iterator get_itr_unsupported_info_map() const { return global_unsupported_str2expr_info.begin(); }
-    std::vector<std::pair<std::string,exprt>>::const_iterator get_itr_end_unsupported_info_map() const { return global_unsupported_str2expr_info.end(); }
+    std::vector<std::pair<std::string,exprt>> get_unsupported_info_map() const { return registry->get_str2expr_info(); }
     /// TODO: REFACTOR - END ///
     
 protected:  
-    static unsigned unsupported2var; // Create a new var hifrog::c::unsupported_op2var#i - smtcheck_opensmt2t::_unsupported_var_str
-  
-    static std::vector<std::pair<std::string,exprt>> global_unsupported_str2expr_info; // String to Expression - can pass between solvers!
-      
     bool store_unsupported_info;
+
+    std::shared_ptr<unsupported_registryt> registry;
   
 };
 
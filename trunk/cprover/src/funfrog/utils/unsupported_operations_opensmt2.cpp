@@ -2,6 +2,8 @@
 
 #include "../solvers/smtcheck_opensmt2.h"
 
+#include <util/irep_hash.h>
+
 /*******************************************************************\
 
 Function: unsupported_operations_opensmt2t::add_func_decl2solver
@@ -21,6 +23,75 @@ SymRef unsupported_operations_opensmt2t::add_func_decl2solver(const char* op, SR
     return ret;    
 }
 
+std::size_t unsupported_operations_opensmt2t::uf_signature_hasht::operator()(const uf_signaturet & signature) const
+{
+    std::size_t hash = signature.op.hash();
+    hash = hash_combine(hash, signature.out.x);
+    for (const SRef & arg : signature.args) {
+        hash = hash_combine(hash, arg.x);
+    }
+    return hash;
+}
+
+/*******************************************************************\
+
+Function: unsupported_operations_opensmt2t::declare_signature
+
+ Outputs: the declaration of the function with the given signature
+
+ Purpose: declares the function in OpenSMT the first time the signature
+ is seen, later only looks it up (no strings are built)
+
+\*******************************************************************/
+SymRef unsupported_operations_opensmt2t::declare_signature(const std::string & func_id, uf_signaturet && signature)
+{
+    auto it = m_uf_signatures.find(signature);
+    if (it != m_uf_signatures.end())
+        return it->second;
+
+    vec<SRef> args_decl;
+    for (const SRef & arg : signature.args)
+        args_decl.push(arg);
+    SRef out = signature.out;
+    SymRef decl = add_func_decl2solver(func_id.c_str(), out, args_decl);
+    assert(decl != SymRef_Undef);
+    m_uf_signatures.emplace(std::move(signature), decl);
+    return decl;
+}
+
+/*******************************************************************\
+
+Function: unsupported_operations_opensmt2t::declare_unsupported_function
+
+  Inputs: the operator, its result sort and its (converted) arguments
+
+ Outputs: the unsupported operator symbol to be used in mkFun, or
+ SymRef_Undef if the expression cannot be over-approximated
+
+ Purpose: the declarations are keyed on (operator, result sort, argument
+ sorts), so each UF is declared once per solver and found without
+ building its string signature
+
+\*******************************************************************/
+SymRef unsupported_operations_opensmt2t::declare_unsupported_function(
+                const irep_idt & op, SRef out, const vec<PTRef> & args)
+{
+    // Works only if unsupported_operations option is on
+    if (!m_can_overapprox || args.size() == 0)
+        return SymRef_Undef; // no args: it is a simple var!
+
+    uf_signaturet signature {op, out, {}};
+    signature.args.reserve(args.size());
+    for (int i=0; i < args.size(); i++)
+        signature.args.push_back(m_decider->getLogic()->getSortRef(args[i]));
+
+    auto it = m_uf_signatures.find(signature);
+    if (it != m_uf_signatures.end())
+        return it->second;
+    return declare_signature(HifrogStringUnsupportOpConstants::UNSUPPORTED_PREFIX_FUNC_NAME + id2string(op),
+                             std::move(signature));
+}
+
 /*******************************************************************\
 
 Function: unsupported_operations_opensmt2t::declare_unsupported_function
@@ -59,20 +130,16 @@ std::string unsupported_operations_opensmt2t::declare_unsupported_function(const
     std::string key_func(func_id.c_str());
     key_func += "," + m_decider->to_string_smtlib_datatype(expr.type());
     
-    vec<SRef> args_decl;
+    uf_signaturet signature {expr.id(), m_decider->get_smtlib_datatype(expr.type()), {}};
     for (int i=0; i < args.size(); i++) 
     {
-        args_decl.push(m_decider->getLogic()->getSortRef(args[i]));
+        signature.args.push_back(m_decider->getLogic()->getSortRef(args[i]));
         key_func += "," + std::string(m_decider->getLogic()->getSortName(m_decider->getLogic()->getSortRef(args[i])));
     }
         
     // Define the function if needed and check it is OK
     if (m_decl_uf.count(key_func) == 0) {
-        SymRef decl = SymRef_Undef;
-        SRef out = m_decider->get_smtlib_datatype(expr.type());
-        decl = add_func_decl2solver(func_id.c_str(), out, args_decl);
-        m_decl_uf.insert(std::pair<std::string, SymRef> (key_func,decl));
-        assert(decl != SymRef_Undef);
+        m_decl_uf.insert(std::pair<std::string, SymRef> (key_func,declare_signature(func_id, std::move(signature))));
     } 
     
     return key_func; 
@@ -90,23 +157,19 @@ std::string unsupported_operations_opensmt2t::declare_unsupported_function(
     // First declare the function, if not exist
     std::string key_func(func_id.c_str());
     
-    vec<SRef> args_decl;
-    args_decl.push(m_decider->get_smtlib_datatype(expr.type()));
+    uf_signaturet signature {func_id, m_decider->get_smtlib_datatype(expr.type()), {}};
+    signature.args.push_back(m_decider->get_smtlib_datatype(expr.type()));
     key_func += "," + m_decider->to_string_smtlib_datatype(expr.type());
 
     for (auto it : operands) {
-      args_decl.push(m_decider->get_smtlib_datatype(it.type()));
+      signature.args.push_back(m_decider->get_smtlib_datatype(it.type()));
       key_func += "," + std::string(m_decider->to_string_smtlib_datatype(it.type()));
     }
 
     
     // Define the function if needed and check it is OK
     if (m_decl_uf.count(key_func) == 0) {
-        SymRef decl = SymRef_Undef;
-        SRef out = m_decider->get_smtlib_datatype(expr.type());
-        decl = add_func_decl2solver(func_id.c_str(), out, args_decl);
-        m_decl_uf.insert(std::pair<std::string, SymRef> (key_func,decl));
-        assert(decl != SymRef_Undef);
+        m_decl_uf.insert(std::pair<std::string, SymRef> (key_func,declare_signature(func_id, std::move(signature))));
     } 
     
     return key_func;     
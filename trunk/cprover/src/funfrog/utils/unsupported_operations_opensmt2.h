@@ -9,6 +9,8 @@
 
 #include "unsupported_operations.h"
 
+#include <unordered_map>
+
 // Add all solvers basic definition
 #include <opensmt/opensmt2.h>
 
@@ -18,8 +20,9 @@ class smtcheck_opensmt2t;
 class unsupported_operations_opensmt2t : public unsupported_operationst
 {
 public:
-    unsupported_operations_opensmt2t(bool _store_unsupported_info, smtcheck_opensmt2t* _decider)
-            :unsupported_operationst(_store_unsupported_info),
+    unsupported_operations_opensmt2t(bool _store_unsupported_info, smtcheck_opensmt2t* _decider,
+                std::shared_ptr<unsupported_registryt> _registry = nullptr)
+            :unsupported_operationst(_store_unsupported_info, _registry),
              m_decider(_decider),
              m_can_overapprox(true)
     { m_can_overapprox = (m_decider!=0);}
@@ -33,13 +36,33 @@ public:
                 const exprt &expr, const exprt::operandst &operands,
 		std::string func_id) override;
     
+    // Declare new unsupported function as UF, once per signature; SymRef_Undef if cannot overapprox
+    SymRef declare_unsupported_function(const irep_idt & op, SRef out, const vec<PTRef> & args);
+    
     SymRef get_declaration(std::string decl_str)
     { assert(m_decl_uf.count(decl_str) > 0); return m_decl_uf.at(decl_str); }
     
 private:
+    // Operator, result sort and argument sorts of an unsupported function
+    struct uf_signaturet {
+        irep_idt op;
+        SRef out;
+        std::vector<SRef> args;
+        bool operator==(const uf_signaturet & other) const
+        { return op == other.op && out == other.out && args == other.args; }
+    };
+    struct uf_signature_hasht {
+        std::size_t operator()(const uf_signaturet & signature) const;
+    };
+
     // Hold uninterpreted functions that the solver was told about
+    std::unordered_map<uf_signaturet,SymRef,uf_signature_hasht> m_uf_signatures;
+    
+    // The same declarations by the string keys of the interface
     std::map<std::string,SymRef> m_decl_uf;
     
+    SymRef declare_signature(const std::string & func_id, uf_signaturet && signature);
+    
     // Decider which we use
     smtcheck_opensmt2t* m_decider;
     
@@ -15,8 +15,9 @@ class smtcheck_z3t;
 class unsupported_operations_z3t : public unsupported_operationst
 {
 public:
-    unsupported_operations_z3t(bool _store_unsupported_info, smtcheck_z3t* _decider)
-            :unsupported_operationst(_store_unsupported_info),
+    unsupported_operations_z3t(bool _store_unsupported_info, smtcheck_z3t* _decider,
+                std::shared_ptr<unsupported_registryt> _registry = nullptr)
+            :unsupported_operationst(_store_unsupported_info, _registry),
              m_decider(_decider),
              m_can_overapprox(true)
     { m_can_overapprox = (m_decider!=0);}
@@ -14,12 +14,18 @@ Date:   September 2014
 #ifndef CPROVER_GOTO_PROGRAMS_REMOVE_VECTOR_H
 #define CPROVER_GOTO_PROGRAMS_REMOVE_VECTOR_H
 
-class goto_functionst;
+#include "goto_functions.h"
+
 class goto_modelt;
 class symbol_tablet;
 
 void remove_vector(symbol_tablet &, goto_functionst &);
 
+// the symbol table and the function parts of the above, for running the
+// latter on several functions concurrently
+void remove_vector(symbol_tablet &);
+void remove_vector(goto_functionst::goto_functiont &);
+
 void remove_vector(goto_modelt &);
 
 #endif // CPROVER_GOTO_PROGRAMS_REMOVE_VECTOR_H
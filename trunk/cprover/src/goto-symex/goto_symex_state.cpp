@@ -193,7 +193,7 @@ void goto_symex_statet::assignment(
 
   // do the l2 renaming
   //SA: adjustment for HiFrog/Upprover's need; increase_counter should n't be static
-  level2.current_names.emplace(l1_identifier, std::make_pair(lhs, 0));
+  level2.add_name(l1_identifier, lhs);
   level2.increase_counter(l1_identifier);
 //  const auto level2_it =
 //    level2.current_names.emplace(l1_identifier, std::make_pair(lhs, 0)).first;
@@ -318,10 +318,12 @@ void goto_symex_statet::rename(
       {
         // We also consider propagation if we go up to L2.
         // L1 identifiers are used for propagation!
-        auto p_it = propagation.find(ssa.get_identifier());
+        // (looked up via a const reference so the shared map is not copied)
+        const propagationt &const_propagation = propagation;
+        const auto p_it = const_propagation.find(ssa.get_identifier());
 
-        if(p_it != propagation.end())
-          expr=p_it->second; // already L2
+        if(p_it.second)
+          expr=p_it.first; // already L2
         else
           set_l2_indices(ssa, ns);
       }
@@ -457,7 +459,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
 //        level2.current_names.emplace(l1_identifier, std::make_pair(ssa_l1, 0))
 //          .first;
 //      symex_renaming_levelt::increase_counter(level2_it);
-      level2.current_names.emplace(l1_identifier, std::make_pair(ssa_l1, 0));
+      level2.add_name(l1_identifier, ssa_l1);
       level2.increase_counter(l1_identifier);
       a_s_read.first=level2.current_count(l1_identifier);
     }
@@ -498,7 +500,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
 //  const auto level2_it =
 //    level2.current_names.emplace(l1_identifier, std::make_pair(ssa_l1, 0))
 //      .first;
-  level2.current_names.emplace(l1_identifier, std::make_pair(ssa_l1, 0));
+  level2.add_name(l1_identifier, ssa_l1);
 
   // No event and no fresh index, but avoid constant propagation
   if(!record_events)
@@ -813,7 +815,10 @@ void goto_symex_statet::print_backtrace(std::ostream &out) const
 /// because there aren't any current callers.
 void goto_symex_statet::output_propagation_map(std::ostream &out)
 {
-  for(const auto &name_value : propagation)
+  propagationt::viewt view;
+  propagation.get_view(view);
+
+  for(const auto &name_value : view)
   {
     out << name_value.first << " <- " << format(name_value.second) << "\n";
   }
@@ -23,6 +23,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/std_expr.h>
 #include <util/ssa_expr.h>
 #include <util/make_unique.h>
+#include <util/sharing_map.h>
 
 #include <pointer-analysis/value_set.h>
 #include <goto-programs/goto_function.h>
@@ -102,8 +103,9 @@ public:
   symex_level1t level1;
   symex_level2t level2;
 
-  // Map L1 names to (L2) constants
-  std::map<irep_idt, exprt> propagation;
+  // Map L1 names to (L2) constants; shared with the saved branch states
+  typedef sharing_mapt<irep_idt, exprt> propagationt;
+  propagationt propagation;
   void output_propagation_map(std::ostream &);
 
   enum levelt { L0=0, L1=1, L2=2 };
@@ -156,10 +158,12 @@ public:
     value_sett value_set;
     guardt guard;
     symex_targett::sourcet source;
-    std::map<irep_idt, exprt> propagation;
+    propagationt propagation;
     unsigned atomic_section_id;
     std::unordered_map<irep_idt, local_safe_pointerst> safe_pointers;
     unsigned total_vccs, remaining_vccs;
+    // size of level2.change_log when the state was saved
+    std::size_t level2_log_size;
 
     explicit goto_statet(const goto_symex_statet &s)
       : depth(s.depth),
@@ -171,7 +175,8 @@ public:
         atomic_section_id(s.atomic_section_id),
         safe_pointers(s.safe_pointers),
         total_vccs(s.total_vccs),
-        remaining_vccs(s.remaining_vccs)
+        remaining_vccs(s.remaining_vccs),
+        level2_log_size(s.level2.change_log.size())
     {
     }
 
@@ -179,14 +184,12 @@ public:
     void level2_get_variables(
       std::unordered_set<ssa_exprt, irep_hash> &vars) const
     {
-      for(const auto &pair : level2_current_names)
-        vars.insert(pair.second.first);
+      symex_level2t::get_variables_in(level2_current_names, vars);
     }
 
     unsigned level2_current_count(const irep_idt &identifier) const
     {
-      const auto it = level2_current_names.find(identifier);
-      return it==level2_current_names.end()?0:it->second.second;
+      return symex_level2t::count_in(level2_current_names, identifier);
     }
   };
 
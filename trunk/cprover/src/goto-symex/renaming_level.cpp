@@ -74,3 +74,25 @@ void symex_level1t::restore_from(
     }
   }
 }
+
+void symex_level2t::get_delta(
+  const symex_level2t::current_namest &first_map,
+  const symex_level2t::current_namest &second_map,
+  std::vector<std::tuple<ssa_exprt, unsigned, unsigned>> &delta)
+{
+  symex_level2t::current_namest::delta_viewt delta_view;
+  first_map.get_delta_view(second_map, delta_view, false);
+  for(const auto &item : delta_view)
+  {
+    delta.emplace_back(
+      item.m.first, item.m.second, item.in_both ? item.other_m.second : 0);
+  }
+
+  delta_view.clear();
+  second_map.get_delta_view(first_map, delta_view, false);
+  for(const auto &item : delta_view)
+  {
+    if(!item.in_both)
+      delta.emplace_back(item.m.first, 0, item.m.second);
+  }
+}
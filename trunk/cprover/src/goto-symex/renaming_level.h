@@ -13,9 +13,12 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 #define CPROVER_GOTO_SYMEX_RENAMING_LEVEL_H
 
 #include <map>
+#include <tuple>
 #include <unordered_set>
+#include <vector>
 
 #include <util/irep.h>
+#include <util/sharing_map.h>
 #include <util/ssa_expr.h>
 
 /// Wrapper for a \c current_names map, which maps each identifier to an SSA
@@ -89,10 +92,92 @@ struct symex_level1t : public symex_renaming_levelt
 /// Functor to set the level 2 renaming of SSA expressions.
 /// Level 2 corresponds to SSA.
 /// This is to ensure each variable is only assigned once.
-struct symex_level2t : public symex_renaming_levelt
+/// Unlike the other levels, the names are kept in a sharing map: the copy
+/// saved with every branch state shares all the unchanged subtrees with the
+/// current state, which makes the copy O(1) and lets the merge compare only
+/// the subtrees that are not shared.
+struct symex_level2t
 {
-  symex_level2t() = default;
-  ~symex_level2t() override = default;
+  /// Map identifier to ssa_exprt and counter
+  typedef sharing_mapt<irep_idt, std::pair<ssa_exprt, unsigned>>
+    current_namest;
+  current_namest current_names;
+
+  /// Counter corresponding to an identifier
+  unsigned current_count(const irep_idt &identifier) const
+  {
+    return count_in(current_names, identifier);
+  }
+
+  /// Counter corresponding to an identifier in the given names
+  static unsigned
+  count_in(const current_namest &names, const irep_idt &identifier)
+  {
+    const auto found = names.find(identifier);
+    return found.second ? found.first.second : 0;
+  }
+
+  /// Whether there is an entry for an identifier
+  bool has_name(const irep_idt &identifier) const
+  {
+    return current_names.has_key(identifier);
+  }
+
+  /// Add an entry with counter 0 for an identifier unless there is one
+  void add_name(const irep_idt &identifier, const ssa_exprt &ssa)
+  {
+    current_names.insert(identifier, std::make_pair(ssa, 0u));
+  }
+
+  /// Increase the counter corresponding to an identifier and log the change
+  void increase_counter(const irep_idt &identifier)
+  {
+    const auto found = current_names.find(identifier);
+    PRECONDITION(found.second);
+    ++found.first.second;
+    record_change(identifier);
+  }
+
+  /// Add the \c ssa_exprt of current_names to vars
+  void get_variables(std::unordered_set<ssa_exprt, irep_hash> &vars) const
+  {
+    get_variables_in(current_names, vars);
+  }
+
+  /// Add the \c ssa_exprt of the given names to vars
+  static void get_variables_in(
+    const current_namest &names,
+    std::unordered_set<ssa_exprt, irep_hash> &vars)
+  {
+    current_namest::viewt view;
+    names.get_view(view);
+    for(const auto &item : view)
+      vars.insert(item.second.first);
+  }
+
+  /// Collects `(ssa, i, j)` for the keys k in the subtrees of the two maps
+  /// that are not shared, where the first map maps k to (ssa, i) and the
+  /// second to (ssa', j). If the first map has an entry for k but not the
+  /// second one then j is 0, and when the first map has no entry for k then
+  /// i = 0. Keys in shared subtrees have the same entry in both maps.
+  static void get_delta(
+    const current_namest &first_map,
+    const current_namest &second_map,
+    std::vector<std::tuple<ssa_exprt, unsigned, unsigned>> &delta);
+
+  /// Log that the entry of \p identifier was changed or removed
+  void record_change(const irep_idt &identifier)
+  {
+    if(record_changes)
+      change_log.push_back(identifier);
+  }
+
+  /// When set, the identifiers whose entries in \c current_names change are
+  /// appended to \c change_log in the order of the changes. A state saved at
+  /// a branch remembers the log size, so the entries that may differ at the
+  /// merge are the ones logged after that position.
+  bool record_changes = false;
+  std::vector<irep_idt> change_log;
 };
 
 #endif // CPROVER_GOTO_SYMEX_RENAMING_LEVEL_H
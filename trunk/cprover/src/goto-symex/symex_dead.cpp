@@ -53,8 +53,7 @@ void goto_symext::symex_dead(statet &state)
 
   // L2 renaming
   //due to the HiFrog's need
-  if(state.level2.current_names.find(l1_identifier)!=
-     state.level2.current_names.end())
+  if(state.level2.has_name(l1_identifier))
     state.level2.increase_counter(l1_identifier);
 //  auto level2_it = state.level2.current_names.find(l1_identifier);
 //  if(level2_it != state.level2.current_names.end())
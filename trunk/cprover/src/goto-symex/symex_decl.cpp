@@ -69,7 +69,7 @@ void goto_symext::symex_decl(statet &state, const symbol_exprt &expr)
   // inlining may yield multiple declarations of the same identifier
   // within the same L1 context
   //SA: revert increase_counter to older https://github.com/diffblue/cbmc/commit/e71ca91c9eeaaa8dda70f18ffb7d2bcea574035d
-  state.level2.current_names.emplace(l1_identifier, std::make_pair(ssa, 0));
+  state.level2.add_name(l1_identifier, ssa);
   state.level2.increase_counter(l1_identifier);
 //  const auto level2_it = state.level2.current_names.emplace(l1_identifier, std::make_pair(ssa, 0)).first;
 //  symex_renaming_levelt::increase_counter(level2_it);
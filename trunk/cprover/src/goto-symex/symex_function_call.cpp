@@ -346,22 +346,26 @@ void goto_symext::pop_frame(statet &state)
     state.level1.restore_from(frame.old_level1);
 
     // clear function-locals from L2 renaming
-    for(auto c_it = state.level2.current_names.begin();
-        c_it != state.level2.current_names.end();) // no ++c_it
+    symex_level2t::current_namest::keyst to_erase;
     {
-      const irep_idt l1_o_id=c_it->second.first.get_l1_object_identifier();
-      // could use iteration over local_objects as l1_o_id is prefix
-      if(
-        frame.local_objects.find(l1_o_id) == frame.local_objects.end() ||
-        (state.threads.size() > 1 &&
-         state.dirty(c_it->second.first.get_object_name())))
+      symex_level2t::current_namest::viewt view;
+      state.level2.current_names.get_view(view);
+      for(const auto &item : view)
       {
-        ++c_it;
-        continue;
+        const irep_idt l1_o_id=item.second.first.get_l1_object_identifier();
+        // could use iteration over local_objects as l1_o_id is prefix
+        if(
+          frame.local_objects.find(l1_o_id) == frame.local_objects.end() ||
+          (state.threads.size() > 1 &&
+           state.dirty(item.second.first.get_object_name())))
+          continue;
+        to_erase.push_back(item.first);
       }
-      auto cur = c_it;
-      ++c_it;
-      state.level2.current_names.erase(cur);
+    }
+    for(const irep_idt &l1_identifier : to_erase)
+    {
+      state.level2.record_change(l1_identifier);
+      state.level2.current_names.erase(l1_identifier, tvt(true));
     }
   }
 
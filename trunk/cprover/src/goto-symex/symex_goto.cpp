@@ -353,39 +353,6 @@ void goto_symext::merge_value_sets(
   dest.value_set.make_union(src.value_set);
 }
 
-/// Applies f to `(k, ssa, i, j)` if the first map maps k to (ssa, i) and
-/// the second to (ssa', j). If the first map has an entry for k but not the
-/// second one then j is 0, and when the first map has no entry for k then i = 0
-static void for_each2(
-  const std::map<irep_idt, std::pair<ssa_exprt, unsigned>> &first_map,
-  const std::map<irep_idt, std::pair<ssa_exprt, unsigned>> &second_map,
-  const std::function<void(const ssa_exprt &, unsigned, unsigned)> &f)
-{
-  auto second_it = second_map.begin();
-  for(const auto &first_pair : first_map)
-  {
-    while(second_it != second_map.end() && second_it->first < first_pair.first)
-    {
-      f(second_it->second.first, 0, second_it->second.second);
-      ++second_it;
-    }
-    const ssa_exprt &ssa = first_pair.second.first;
-    const unsigned count = first_pair.second.second;
-    if(second_it != second_map.end() && second_it->first == first_pair.first)
-    {
-      f(ssa, count, second_it->second.second);
-      ++second_it;
-    }
-    else
-      f(ssa, count, 0);
-  }
-  while(second_it != second_map.end())
-  {
-    f(second_it->second.first, 0, second_it->second.second);
-    ++second_it;
-  }
-}
-
 /// Helper function for \c phi_function which merges the names of an identifier
 /// for two different states.
 /// \param goto_state: first state
@@ -448,17 +415,19 @@ static void merge_names(
   {
     const auto p_it = goto_state.propagation.find(l1_identifier);
 
-    if(p_it != goto_state.propagation.end())
-      goto_state_rhs = p_it->second;
+    if(p_it.second)
+      goto_state_rhs = p_it.first;
     else
       to_ssa_expr(goto_state_rhs).set_level_2(goto_count);
   }
 
   {
-    const auto p_it = dest_state.propagation.find(l1_identifier);
+    const goto_symext::statet::propagationt &dest_propagation =
+      dest_state.propagation;
+    const auto p_it = dest_propagation.find(l1_identifier);
 
-    if(p_it != dest_state.propagation.end())
-      dest_state_rhs = p_it->second;
+    if(p_it.second)
+      dest_state_rhs = p_it.first;
     else
       to_ssa_expr(dest_state_rhs).set_level_2(dest_count);
   }
@@ -524,23 +493,28 @@ void goto_symext::phi_function(
   // this gets the diff between the guards
   diff_guard -= dest_state.guard;
 
-  for_each2(
-    goto_state.level2_current_names,
-    dest_state.level2.current_names,
-    [&](const ssa_exprt &ssa, unsigned goto_count, unsigned dest_count) {
-      merge_names(
-        goto_state,
-        dest_state,
-        ns,
-        diff_guard,
-        guard_identifier,
-        log,
-        symex_config.simplify_opt,
-        target,
-        ssa,
-        goto_count,
-        dest_count);
-    });
+  // only the entries in subtrees that the two maps do not share can differ;
+  // the names and counters are copied before merging, as merge_names
+  // modifies the names of dest_state
+  std::vector<std::tuple<ssa_exprt, unsigned, unsigned>> changed;
+  symex_level2t::get_delta(
+    goto_state.level2_current_names, dest_state.level2.current_names, changed);
+
+  for(const auto &item : changed)
+  {
+    merge_names(
+      goto_state,
+      dest_state,
+      ns,
+      diff_guard,
+      guard_identifier,
+      log,
+      symex_config.simplify_opt,
+      target,
+      std::get<0>(item),
+      std::get<1>(item),
+      std::get<2>(item));
+  }
 }
 
 void goto_symext::loop_bound_exceeded(
@@ -98,7 +98,7 @@ void irept::detach()
 #ifdef SHARING
 void irept::remove_ref(dt *old_data)
 {
-  if(old_data==&empty_d)
+  if(old_data==&empty_d || old_data->ref_count==frozen_ref_count)
     return;
 
   #if 0
@@ -111,8 +111,10 @@ void irept::remove_ref(dt *old_data)
   std::cout << "R: " << old_data << " " << old_data->ref_count << '\n';
   #endif
 
-  old_data->ref_count--;
-  if(old_data->ref_count==0)
+  // the last owner can skip the (atomic) decrement, nobody else can take
+  // a new reference; otherwise decrement and test in a single step, as
+  // another thread may drop its reference at the same time
+  if(old_data->ref_count==1 || --old_data->ref_count==0)
   {
     #ifdef IREP_DEBUG
     std::cout << "D: " << pretty() << '\n';
@@ -144,13 +146,12 @@ void irept::nonrecursive_destructor(dt *old_data)
   {
     dt *d=stack.back();
     stack.erase(--stack.end());
-    if(d==&empty_d)
+    if(d==&empty_d || d->ref_count==frozen_ref_count)
       continue;
 
     INVARIANT(d->ref_count!=0, "All contents of the stack must be in use");
-    d->ref_count--;
 
-    if(d->ref_count==0)
+    if(d->ref_count==1 || --d->ref_count==0)
     {
       stack.reserve(stack.size()+
                     d->named_sub.size()+
@@ -191,6 +192,32 @@ void irept::nonrecursive_destructor(dt *old_data)
 }
 #endif
 
+void irept::freeze()
+{
+  #ifdef SHARING
+  std::vector<dt *> stack(1, data);
+
+  while(!stack.empty())
+  {
+    dt *d=stack.back();
+    stack.pop_back();
+    if(d==&empty_d || d->ref_count==frozen_ref_count)
+      continue;
+
+    // nodes shared with unfrozen ireps are frozen as well; their other
+    // owners will copy them on write and never free them
+    d->ref_count=frozen_ref_count;
+
+    for(const auto &named : d->named_sub)
+      stack.push_back(named.second.data);
+    for(const auto &comment : d->comments)
+      stack.push_back(comment.second.data);
+    for(const auto &sub : d->sub)
+      stack.push_back(sub.data);
+  }
+  #endif
+}
+
 void irept::move_to_named_sub(const irep_namet &name, irept &irep)
 {
   #ifdef SHARING
@@ -28,6 +28,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #endif
 
+// With IREP_THREAD_SAFE the reference counts are atomic, so that
+// ireps may be copied and destroyed concurrently by several threads.
+#ifdef IREP_THREAD_SAFE
+#include <atomic>
+#endif
+
 #ifdef USE_DSTRING
 typedef dstringt irep_idt;
 typedef dstringt irep_namet;
@@ -189,7 +195,7 @@ public:
   // copy constructor
   irept(const irept &irep):data(irep.data)
   {
-    if(data!=&empty_d)
+    if(data!=&empty_d && data->ref_count!=frozen_ref_count)
     {
       // NOLINTNEXTLINE(build/deprecated)
       PRECONDITION(data->ref_count != 0);
@@ -222,7 +228,7 @@ public:
     // Ordering is very important here!
     // Consider self-assignment, which may destroy 'irep'
     dt *irep_data=irep.data;
-    if(irep_data!=&empty_d)
+    if(irep_data!=&empty_d && irep_data->ref_count!=frozen_ref_count)
       irep_data->ref_count++;
 
     remove_ref(data); // this may kill 'irep'
@@ -339,8 +345,12 @@ public:
     friend class irept;
 
     #ifdef SHARING
+    #ifdef IREP_THREAD_SAFE
+    std::atomic<unsigned> ref_count;
+    #else
     unsigned ref_count;
     #endif
+    #endif
 
     /// This irep_idt is the only place to store data in an irep, other than
     /// the mere nesting structure
@@ -383,6 +393,21 @@ public:
       #endif
     {
     }
+
+    #ifdef IREP_THREAD_SAFE
+    // atomics cannot be copied; a copy is not shared yet
+    dt(const dt &other):
+      ref_count(1),
+      data(other.data),
+      named_sub(other.named_sub),
+      comments(other.comments),
+      sub(other.sub)
+      #ifdef HASH_CODE
+      , hash_code(other.hash_code)
+      #endif
+    {
+    }
+    #endif
     #else
     dt()
       #ifdef HASH_CODE
@@ -393,8 +418,19 @@ public:
     #endif
   };
 
+public:
+  /// Marks the irep and all ireps below it as immutable. Copying and
+  /// destroying a frozen irep does not touch its reference count, so it
+  /// can be read by several threads without any synchronization; writing
+  /// to it makes a private copy first. Frozen nodes are never freed. The
+  /// irep must not be in use by other threads while it is being frozen.
+  void freeze();
+
 protected:
   #ifdef SHARING
+  // the reference count of frozen nodes
+  static const unsigned frozen_ref_count=~0u;
+
   dt *data;
   static dt empty_d;
 
@@ -51,10 +51,13 @@ enum class idt:unsigned
 
 #include "irep_ids.def" // NOLINT(build/include)
 
-string_containert::string_containert()
+string_containert::string_containert():next_no(0)
 {
+  for(auto &block : blocks)
+    block.store(nullptr, std::memory_order_relaxed);
+
   // pre-allocate empty string -- this gets index 0
-  get("");
+  operator[]("");
 
   // allocate strings
   for(unsigned i=0; irep_ids_table[i]!=nullptr; i++)
@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cstring>
 
+#include "invariant.h"
+
 string_ptrt::string_ptrt(const char *_s):s(_s), len(strlen(_s))
 {
 }
@@ -27,50 +29,47 @@ bool string_ptrt::operator==(const string_ptrt &other) const
 
 string_containert::~string_containert()
 {
+  for(auto &block : blocks)
+    delete[] block.load();
 }
 
-unsigned string_containert::get(const char *s)
+unsigned string_containert::get(const string_ptrt &s)
 {
-  string_ptrt string_ptr(s);
+  shardt &shard=shards[hash_string(s.s)%shard_count];
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  shardt::hash_tablet::const_iterator it=shard.hash_table.find(s);
 
-  if(it!=hash_table.end())
+  if(it!=shard.hash_table.end())
     return it->second;
 
-  size_t r=hash_table.size();
-
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
-
-  hash_table[result]=r;
+  const unsigned r=next_no++;
+  INVARIANT(
+    r < (max_blocks << block_bits), "string container must not overflow");
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  shard.strings.emplace_back(s.s, s.len);
+  const std::string &stored=shard.strings.back();
+  publish(r, &stored);
+  shard.hash_table.emplace(string_ptrt(stored), r);
 
   return r;
 }
 
-unsigned string_containert::get(const std::string &s)
+/// Makes string `s` available under number `no`, allocating the block of
+/// the number if no other thread has done so yet.
+void string_containert::publish(unsigned no, const std::string *s)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
-
-  if(it!=hash_table.end())
-    return it->second;
-
-  size_t r=hash_table.size();
-
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result]=r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  std::atomic<blockt *> &slot=blocks[no>>block_bits];
+  blockt *block=slot.load(std::memory_order_acquire);
+
+  if(block==nullptr)
+  {
+    blockt *fresh=new blockt[block_mask+1]();
+    if(slot.compare_exchange_strong(block, fresh, std::memory_order_acq_rel))
+      block=fresh;
+    else
+      delete[] fresh; // block is the one allocated by another thread
+  }
+
+  block[no&block_mask]=s;
 }
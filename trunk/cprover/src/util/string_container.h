@@ -12,7 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
+#include <atomic>
+#include <deque>
 #include <list>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -44,17 +47,24 @@ public:
   size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
 };
 
+/// Interns strings, giving each one a number. The container may be used
+/// from several threads: the strings are spread over shards, each guarded
+/// by its own mutex, and the numbers are looked up without locking through
+/// a table of fixed-size blocks that never move. The stored strings are
+/// never modified or freed, so the numbers and the returned references are
+/// stable. Numbers are handed out in the order of insertion; with several
+/// threads interning at once, that order is not deterministic.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
@@ -64,29 +74,46 @@ public:
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    return *blocks[no >> block_bits].load(std::memory_order_acquire)
+      [no & block_mask];
   }
 
 protected:
-  // the 'unsigned' ought to be size_t
-  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
-    hash_tablet;
-  hash_tablet hash_table;
+  static const unsigned shard_count = 64;
+  static const unsigned block_bits = 16;
+  static const size_t block_mask = (size_t(1) << block_bits) - 1;
+  // room for 2^28 strings; the table of blocks takes 32KB
+  static const size_t max_blocks = size_t(1) << 12;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  struct shardt
+  {
+    std::mutex mutex;
+
+    // the 'unsigned' ought to be size_t
+    typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
+      hash_tablet;
+    hash_tablet hash_table;
+
+    // these are stable
+    std::deque<std::string> strings;
+  };
+
+  shardt shards[shard_count];
+
+  // number -> string, allocated a block at a time
+  typedef const std::string *blockt;
+  std::atomic<blockt *> blocks[max_blocks];
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  std::atomic<unsigned> next_no;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  unsigned get(const string_ptrt &s);
+  void publish(unsigned no, const std::string *s);
 };
 
 /// Get a reference to the global string container.
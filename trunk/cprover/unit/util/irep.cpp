@@ -0,0 +1,62 @@
+/*******************************************************************\
+
+ Module: irept unit tests
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <util/irep.h>
+
+TEST_CASE("Copies of a frozen irep share its nodes", "[core][util][irep]")
+{
+  irept irep("frozen");
+  irep.get_sub().push_back(irept("child"));
+  irep.set("name", "value");
+  irep.freeze();
+
+  const irept &frozen=irep;
+  const irept copy=frozen;
+  REQUIRE(&copy.read()==&frozen.read());
+  REQUIRE(&copy.get_sub()[0].read()==&frozen.get_sub()[0].read());
+  REQUIRE(copy.get("name")=="value");
+}
+
+TEST_CASE("Writing to a frozen irep detaches a private copy", "[core][util][irep]")
+{
+  irept irep("frozen");
+  irep.get_sub().push_back(irept("child"));
+  irep.freeze();
+  const irept &frozen=irep;
+
+  irept copy=frozen;
+  copy.id("changed");
+  REQUIRE(&copy.read()!=&frozen.read());
+  REQUIRE(copy.id()=="changed");
+  REQUIRE(frozen.id()=="frozen");
+
+  // the children of the private copy are still the frozen ones
+  const irept &copy_child=static_cast<const irept &>(copy).get_sub()[0];
+  REQUIRE(&copy_child.read()==&frozen.get_sub()[0].read());
+
+  copy.get_sub()[0].id("changed child");
+  REQUIRE(copy.get_sub()[0].id()=="changed child");
+  REQUIRE(frozen.get_sub()[0].id()=="child");
+}
+
+TEST_CASE("Frozen nodes outlive their owners", "[core][util][irep]")
+{
+  irept shared("shared");
+  irept *owner=new irept("owner");
+  owner->get_sub().push_back(shared);
+  owner->freeze();
+
+  // nodes shared with an unfrozen irep are frozen too
+  const irept child=static_cast<const irept &>(*owner).get_sub()[0];
+  REQUIRE(&child.read()==&shared.read());
+  delete owner;
+  REQUIRE(child.id()=="shared");
+
+  shared.id("detached");
+  REQUIRE(shared.id()=="detached");
+  REQUIRE(child.id()=="shared");
+}